@@ -34,6 +34,7 @@
 #include <bitcoin/database/memory/map.hpp>
 #include <bitcoin/database/memory/memory.hpp>
 #include <bitcoin/database/memory/reader.hpp>
+#include <bitcoin/database/memory/segments.hpp>
 #include <bitcoin/database/memory/writer.hpp>
 #include <bitcoin/database/memory/interfaces/memory.hpp>
 #include <bitcoin/database/memory/interfaces/storage.hpp>
@@ -44,6 +45,8 @@
 #include <bitcoin/database/primitives/linkage.hpp>
 #include <bitcoin/database/primitives/manager.hpp>
 #include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/primitives/view.hpp>
+#include <bitcoin/database/tables/compression.hpp>
 #include <bitcoin/database/tables/context.hpp>
 #include <bitcoin/database/tables/schema.hpp>
 #include <bitcoin/database/tables/tables.hpp>
@@ -54,6 +57,8 @@
 #include <bitcoin/database/tables/archives/puts.hpp>
 #include <bitcoin/database/tables/archives/transaction.hpp>
 #include <bitcoin/database/tables/archives/txs.hpp>
+#include <bitcoin/database/tables/archives/witness.hpp>
+#include <bitcoin/database/tables/caches/balance.hpp>
 #include <bitcoin/database/tables/caches/bootstrap.hpp>
 #include <bitcoin/database/tables/caches/buffer.hpp>
 #include <bitcoin/database/tables/caches/neutrino.hpp>
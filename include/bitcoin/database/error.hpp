@@ -75,6 +75,7 @@ enum error_t
     backup_table,
     restore_table,
     verify_table,
+    store_version,
 
     // states
     tx_connected,
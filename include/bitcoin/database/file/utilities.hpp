@@ -60,6 +60,13 @@ BCD_API int open(const path& filename) NOEXCEPT;
 BCD_API bool close(int file_descriptor) NOEXCEPT;
 BCD_API bool size(size_t& out, int file_descriptor) NOEXCEPT;
 
+/// Extend file to size with allocated (not sparse) blocks, never shrinks.
+BCD_API bool allocate(int file_descriptor, size_t size) NOEXCEPT;
+
+/// Allocate blocks for [offset, offset + size) without changing file size.
+/// Advisory, true (without effect) where not supported by the platform.
+BCD_API bool reserve(int file_descriptor, size_t offset, size_t size) NOEXCEPT;
+
 /// File size from name.
 BCD_API bool size(size_t& out, const path& filename) NOEXCEPT;
 
@@ -85,12 +85,46 @@ bool CLASS::truncate(const Link& count) NOEXCEPT
     return manager_.truncate(count);
 }
 
+TEMPLATE
+memory_ptr CLASS::get_memory(const Link& link) const NOEXCEPT
+{
+    return manager_.get(link);
+}
+
+TEMPLATE
+void CLASS::prefetch(const Link& link) const NOEXCEPT
+{
+    manager_.prefetch(link);
+}
+
 TEMPLATE
 template <typename Element, if_equal<Element::size, Size>>
 bool CLASS::get(const Link& link, Element& element) const NOEXCEPT
 {
-    auto source = getter(link);
-    return source && element.from_data(*source);
+    // Reader is not heap allocated, as it does not outlive the call.
+    const auto ptr = manager_.get(link);
+    if (!ptr)
+        return false;
+
+    reader source{ ptr };
+
+    // Limits to single record or eof for slab.
+    if constexpr (!is_slab) { source.set_limit(Size); }
+    return element.from_data(source);
+}
+
+TEMPLATE
+Link CLASS::allocate(const Link& size) NOEXCEPT
+{
+    return manager_.allocate(size);
+}
+
+TEMPLATE
+template <typename Element, if_equal<Element::size, Size>>
+bool CLASS::set(const Link& link, const Element& element) NOEXCEPT
+{
+    auto sink = setter(link, element.count());
+    return sink && element.to_data(*sink);
 }
 
 TEMPLATE
@@ -138,14 +172,21 @@ TEMPLATE
 writer_ptr CLASS::creater(Link& link, const Link& size) NOEXCEPT
 {
     link = manager_.allocate(size);
+    return setter(link, size);
+}
+
+TEMPLATE
+writer_ptr CLASS::setter(const Link& link, const Link& size) NOEXCEPT
+{
     const auto ptr = manager_.get(link);
     if (!ptr)
         return {};
 
     const auto sink = std::make_shared<writer>(ptr);
 
-    // Limits to size records or eof for slab.
-    if constexpr (!is_slab) { sink->set_limit(Size * size); }
+    // Limits to size records, or size bytes for slab.
+    if constexpr (is_slab) { sink->set_limit(size); }
+    else { sink->set_limit(Size * size); }
     return sink;
 }
 
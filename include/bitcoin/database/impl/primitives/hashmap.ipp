@@ -73,6 +73,12 @@ bool CLASS::verify() const NOEXCEPT
 // query interface
 // ----------------------------------------------------------------------------
 
+TEMPLATE
+Link CLASS::count() const NOEXCEPT
+{
+    return manager_.count();
+}
+
 TEMPLATE
 bool CLASS::exists(const Key& key) const NOEXCEPT
 {
@@ -92,6 +98,13 @@ typename CLASS::iterator CLASS::it(const Key& key) const NOEXCEPT
     return { manager_.get(), header_.top(key), key };
 }
 
+TEMPLATE
+typename CLASS::iterator CLASS::it(const Key& key,
+    const Link& start) const NOEXCEPT
+{
+    return { manager_.get(), start, key };
+}
+
 TEMPLATE
 Link CLASS::allocate(const Link& size) NOEXCEPT
 {
@@ -112,12 +125,33 @@ Key CLASS::get_key(const Link& link) NOEXCEPT
         ptr->begin(), Link::size));
 }
 
+TEMPLATE
+memory_ptr CLASS::get_memory(const Link& link) const NOEXCEPT
+{
+    return manager_.get(link);
+}
+
+TEMPLATE
+void CLASS::prefetch(const Link& link) const NOEXCEPT
+{
+    manager_.prefetch(link);
+}
+
 TEMPLATE
 template <typename Element, if_equal<Element::size, Size>>
 bool CLASS::get(const Link& link, Element& element) const NOEXCEPT
 {
-    auto source = streamer<reader>(link);
-    return source && element.from_data(*source);
+    // Reader is not heap allocated, as it does not outlive the call.
+    const auto ptr = manager_.get(link);
+    if (!ptr)
+        return false;
+
+    reader source{ ptr };
+    source.skip_bytes(Link::size + array_count<Key>);
+
+    // Limits to single record or eof for slab.
+    if constexpr (!is_slab) { source.set_limit(Size); }
+    return element.from_data(source);
 }
 
 TEMPLATE
@@ -29,6 +29,9 @@ TEMPLATE
 CLASS::manager(storage& file) NOEXCEPT
   : file_(file)
 {
+    // Record links are positions divided by record size.
+    if constexpr (!is_slab)
+        file_.align(link_to_position(Link{ 1 }));
 }
 
 TEMPLATE
@@ -76,6 +79,22 @@ memory_ptr CLASS::get(const Link& value) const NOEXCEPT
     return file_.get(link_to_position(value));
 }
 
+TEMPLATE
+void CLASS::prefetch(const Link& value) const NOEXCEPT
+{
+    if (value.is_terminal())
+        return;
+
+    if constexpr (is_slab)
+    {
+        file_.prefetch(link_to_position(value), one);
+    }
+    else
+    {
+        file_.prefetch(link_to_position(value), link_to_position(Link{ 1 }));
+    }
+}
+
 // private
 // ----------------------------------------------------------------------------
 
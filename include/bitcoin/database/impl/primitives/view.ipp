@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_VIEW_IPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_VIEW_IPP
+
+#include <iterator>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+TEMPLATE
+CLASS::view() NOEXCEPT
+  : memory_{}, data_{}
+{
+}
+
+TEMPLATE
+CLASS::view(memory_ptr memory) NOEXCEPT
+  : memory_(is_complete(memory) ? std::move(memory) : nullptr),
+    data_(memory_ ? std::next(memory_->begin(), Prefix) : nullptr)
+{
+}
+
+TEMPLATE
+CLASS::operator bool() const NOEXCEPT
+{
+    return !is_null(data_);
+}
+
+// protected
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+template <size_t Offset, typename Integer, size_t Bytes>
+inline Integer CLASS::read_little_endian() const NOEXCEPT
+{
+    static_assert(Bytes <= sizeof(Integer));
+    static_assert(Offset + Bytes <= Size);
+    if (is_null(data_))
+        return {};
+
+    // Byte array casts are unaligned-safe (alignment of one).
+    Integer value{ 0 };
+    system::unsafe_array_cast<uint8_t, Bytes>(&value) =
+        system::unsafe_array_cast<uint8_t, Bytes>(std::next(data_, Offset));
+    return system::native_from_little_end(value);
+}
+
+TEMPLATE
+template <size_t Offset>
+inline uint8_t CLASS::read_byte() const NOEXCEPT
+{
+    static_assert(Offset < Size);
+    return is_null(data_) ? 0 : *std::next(data_, Offset);
+}
+
+TEMPLATE
+template <size_t Offset>
+inline hash_digest CLASS::read_hash() const NOEXCEPT
+{
+    static_assert(Offset + system::hash_size <= Size);
+    if (is_null(data_))
+        return {};
+
+    return system::unsafe_array_cast<uint8_t, system::hash_size>(
+        std::next(data_, Offset));
+}
+
+// private
+// ----------------------------------------------------------------------------
+
+TEMPLATE
+bool CLASS::is_complete(const memory_ptr& memory) NOEXCEPT
+{
+    // memory.size() may be negative (treated as truncated).
+    return memory && !system::is_negative(memory->size()) &&
+        system::to_unsigned(memory->size()) >= Prefix + Size;
+}
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
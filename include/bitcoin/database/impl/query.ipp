@@ -20,6 +20,7 @@
 #define LIBBITCOIN_DATABASE_QUERY_IPP
 
 #include <algorithm>
+#include <map>
 #include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
@@ -75,7 +76,7 @@ BC_PUSH_WARNING(NO_USE_OF_MOVED_OBJECT)
 
 TEMPLATE
 CLASS::query(Store& value) NOEXCEPT
-  : store_(value)
+  : store_(value), tx_states_(cached_tx_states)
 {
 }
 
@@ -106,11 +107,37 @@ inline size_t CLASS::get_top_candidate() NOEXCEPT
 TEMPLATE
 size_t CLASS::get_fork() NOEXCEPT
 {
-    for (auto height = get_top_confirmed(); !is_zero(height); --height)
-        if (to_confirmed(height) == to_candidate(height))
-            return height;
+    // Each header commits to its parent, so chain tops determine the fork.
+    const auto confirmed = get_top_confirmed();
+    const auto candidate = get_top_candidate();
+    const auto confirmed_top = to_confirmed(confirmed);
+    const auto candidate_top = to_candidate(candidate);
+    refresh();
 
-    return zero;
+    {
+        std::shared_lock lock{ fork_mutex_ };
+        if (fork_confirmed_ == confirmed_top &&
+            fork_candidate_ == candidate_top)
+            return fork_;
+    }
+
+    // Chains are equal at and below the fork and unequal above it.
+    auto low = zero;
+    auto high = std::min(confirmed, candidate);
+    while (low < high)
+    {
+        const auto middle = high - ((high - low) >> 1);
+        if (to_confirmed(middle) == to_candidate(middle))
+            low = middle;
+        else
+            high = sub1(middle);
+    }
+
+    std::unique_lock lock{ fork_mutex_ };
+    fork_ = low;
+    fork_confirmed_ = confirmed_top;
+    fork_candidate_ = candidate_top;
+    return low;
 }
 
 TEMPLATE
@@ -119,20 +146,34 @@ size_t CLASS::get_last_associated_from(size_t height) NOEXCEPT
     if (height >= height_link::terminal)
         return max_size_t;
 
-    while (is_associated(to_candidate(++height)));
-    return --height;
+    // Candidate links are read in batches, association is cached once seen.
+    header_links links{};
+    while (to_candidates(links, add1(height), candidate_batch))
+    {
+        for (const auto& link: links)
+        {
+            if (!is_associated(link))
+                return height;
+
+            ++height;
+        }
+    }
+
+    return height;
 }
 
 TEMPLATE
 hashes CLASS::get_all_unassociated_above(size_t height) NOEXCEPT
 {
     hashes out{};
-    const auto top = get_top_candidate();
-    while (height < top)
+    header_links links{};
+    while (to_candidates(links, add1(height), candidate_batch))
     {
-        const auto header_fk = to_candidate(++height);
-        if (!is_associated(header_fk))
-            out.push_back(get_header_key(header_fk));
+        for (const auto& link: links)
+            if (!is_associated(link))
+                out.push_back(get_header_key(link));
+
+        height += links.size();
     }
 
     return out;
@@ -167,7 +208,12 @@ inline header_link CLASS::to_candidate(size_t height) NOEXCEPT
     if (height >= store_.candidate.count())
         return {};
 
-    return system::possible_narrow_cast<table::height::block::integer>(height);
+    table::height::record candidate{};
+    const auto link = system::possible_narrow_cast<height_link::integer>(height);
+    if (!store_.candidate.get(link, candidate))
+        return {};
+
+    return candidate.header_fk;
 }
 
 TEMPLATE
@@ -176,7 +222,33 @@ inline header_link CLASS::to_confirmed(size_t height) NOEXCEPT
     if (height >= store_.confirmed.count())
         return {};
 
-    return system::possible_narrow_cast<table::height::block::integer>(height);
+    table::height::record confirmed{};
+    const auto link = system::possible_narrow_cast<height_link::integer>(height);
+    if (!store_.confirmed.get(link, confirmed))
+        return {};
+
+    return confirmed.header_fk;
+}
+
+// protected
+TEMPLATE
+bool CLASS::to_candidates(header_links& out, size_t height,
+    size_t count) NOEXCEPT
+{
+    // The read is truncated at the candidate top and at the segment end.
+    const auto top = store_.candidate.count();
+    if (height >= top || is_zero(count))
+        return false;
+
+    table::height::record_range candidates{};
+    candidates.header_fks.resize(std::min(count, top - height));
+    const auto link = system::possible_narrow_cast<height_link::integer>(height);
+    if (!store_.candidate.get(link, candidates) ||
+        candidates.header_fks.empty())
+        return false;
+
+    out = std::move(candidates.header_fks);
+    return true;
 }
 
 TEMPLATE
@@ -295,22 +367,22 @@ header_link CLASS::to_block(const tx_link& link) NOEXCEPT
     if (fk.is_terminal())
         return {};
 
-    table::strong_tx::record strong{};
-    if (!store_.strong_tx.get(fk, strong))
+    const table::strong_tx::view strong{ store_.strong_tx.get_memory(fk) };
+    if (!strong)
         return {};
 
-    return strong.header_fk;
+    return strong.header_fk();
 }
 
 TEMPLATE
 header_link CLASS::to_parent(const header_link& link) NOEXCEPT
 {
-    table::header::get_parent_fk header{};
-    if (!store_.header.get(link, header))
+    chain_header header{};
+    if (!get_cached_header(header, link))
         return {};
 
     // Terminal implies genesis (no parent).
-    return header.parent_fk;
+    return header.parent;
 }
 
 // output to spenders (reverse navigation)
@@ -373,13 +445,13 @@ input_links CLASS::to_spenders(const table::input::search_key& key) NOEXCEPT
 TEMPLATE
 input_links CLASS::to_tx_inputs(const tx_link& link) NOEXCEPT
 {
-    table::transaction::record_puts tx{};
-    if (!store_.tx.get(link, tx))
+    const table::transaction::view tx{ store_.tx.get_memory(link) };
+    if (!tx)
         return {};
 
     table::puts::record puts{};
-    puts.in_fks.resize(tx.ins_count);
-    if (!store_.puts.get(tx.ins_fk, puts))
+    puts.in_fks.resize(tx.ins_count());
+    if (!store_.puts.get(tx.ins_fk(), puts))
         return {};
 
     return std::move(puts.in_fks);
@@ -388,12 +460,12 @@ input_links CLASS::to_tx_inputs(const tx_link& link) NOEXCEPT
 TEMPLATE
 output_links CLASS::to_tx_outputs(const tx_link& link) NOEXCEPT
 {
-    table::transaction::record_puts tx{};
-    if (!store_.tx.get(link, tx))
+    const table::transaction::view tx{ store_.tx.get_memory(link) };
+    if (!tx)
         return {};
 
     table::puts::record puts{};
-    puts.out_fks.resize(tx.outs_count);
+    puts.out_fks.resize(tx.outs_count());
     if (!store_.puts.get(tx.outs_fk(), puts))
         return {};
 
@@ -488,7 +560,82 @@ inline bool CLASS::is_coinbase(const tx_link& link) NOEXCEPT
 TEMPLATE
 inline bool CLASS::is_associated(const header_link& link) NOEXCEPT
 {
-    return !link.is_terminal() && store_.txs.exists(link);
+    if (link.is_terminal())
+        return false;
+
+    refresh();
+
+    {
+        std::shared_lock lock{ associated_mutex_ };
+        if (link.value < associated_.size() && associated_.at(link.value))
+            return true;
+    }
+
+    if (!store_.txs.exists(link))
+        return false;
+
+    set_associated(link);
+    return true;
+}
+
+// protected
+TEMPLATE
+void CLASS::set_associated(const header_link& link) NOEXCEPT
+{
+    // Association is never removed, so the bitmap only grows.
+    std::unique_lock lock{ associated_mutex_ };
+    if (link.value >= associated_.size())
+        associated_.resize(add1(link.value));
+
+    associated_.at(link.value) = true;
+}
+
+// protected
+TEMPLATE
+void CLASS::refresh() NOEXCEPT
+{
+    // Cached state derives from table contents, which are replaced by create
+    // and by open (which follows restore), so all caches are reset together.
+    const auto generation = store_.generation();
+    if (generation_.load() == generation)
+        return;
+
+    {
+        std::unique_lock lock{ coins_mutex_ };
+        coins_.clear();
+        coins_top_ = {};
+        coins_count_ = {};
+        coins_rows_ = {};
+    }
+    {
+        std::unique_lock lock{ headers_mutex_ };
+        headers_.clear();
+    }
+    {
+        std::unique_lock lock{ fork_mutex_ };
+        fork_ = {};
+        fork_confirmed_ = {};
+        fork_candidate_ = {};
+    }
+    {
+        std::unique_lock lock{ associated_mutex_ };
+        associated_.clear();
+    }
+
+    // Invalidate each tx state slot, waiting out any concurrent writer.
+    for (auto& slot: tx_states_)
+    {
+        auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        while (is_odd(sequence) || !slot.sequence.compare_exchange_weak(
+            sequence, add1(sequence), std::memory_order_acquire))
+            sequence = slot.sequence.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.tx.store(tx_link::terminal, std::memory_order_relaxed);
+        slot.sequence.store(sequence + two, std::memory_order_release);
+    }
+
+    generation_.store(generation);
 }
 
 TEMPLATE
@@ -700,20 +847,20 @@ typename CLASS::transactions_ptr CLASS::get_transactions(
 TEMPLATE
 typename CLASS::header::cptr CLASS::get_header(const header_link& link) NOEXCEPT
 {
-    table::header::record child{};
-    if (!store_.header.get(link, child))
+    chain_header child{};
+    if (!get_cached_header(child, link))
         return {};
 
     // Terminal parent implies genesis (no parent header).
-    table::header::record_sk parent{};
-    if ((child.parent_fk != table::header::link::terminal) &&
-        !store_.header.get(child.parent_fk, parent))
+    chain_header parent{};
+    if (!child.parent.is_terminal() &&
+        !get_cached_header(parent, child.parent))
         return {};
 
     return system::to_shared<header>
     (
         child.version,
-        std::move(parent.key),
+        std::move(parent.hash),
         std::move(child.merkle_root),
         child.timestamp,
         child.bits,
@@ -792,6 +939,15 @@ typename CLASS::input::cptr CLASS::get_input(const input_link& link) NOEXCEPT
     if (!store_.input.get(link, in))
         return {};
 
+    if (in.is_external())
+    {
+        table::witness::only wit{};
+        if (!store_.witness.get(in.witness_fk, wit))
+            return {};
+
+        in.witness = wit.witness;
+    }
+
     // Share null point instances to reduce memory consumption.
     static const auto null_point = system::to_shared<const point>();
 
@@ -846,6 +1002,183 @@ typename CLASS::input::cptr CLASS::get_input(const tx_link& link,
     return get_input(to_input(link, input_index));
 }
 
+TEMPLATE
+bool CLASS::get_transaction_data(system::data_chunk& out, const tx_link& link,
+    bool witness) NOEXCEPT
+{
+    size_t size{};
+    if (!get_tx_size(size, link, witness))
+        return false;
+
+    out.resize(size);
+    system::write::bytes::copy sink{ out };
+    return write_transaction(sink, link, witness) &&
+        (sink.get_write_position() == size);
+}
+
+TEMPLATE
+bool CLASS::get_block_data(system::data_chunk& out, const header_link& link,
+    bool witness) NOEXCEPT
+{
+    size_t size{};
+    if (!get_block_size(size, link, witness))
+        return false;
+
+    out.resize(size);
+    system::write::bytes::copy sink{ out };
+    return write_block(sink, link, witness) &&
+        (sink.get_write_position() == size);
+}
+
+TEMPLATE
+bool CLASS::get_tx_size(size_t& out, const tx_link& link,
+    bool witness) NOEXCEPT
+{
+    const table::transaction::view tx{ store_.tx.get_memory(link) };
+    if (!tx)
+        return false;
+
+    out = witness ? tx.heavy() : tx.light();
+    return true;
+}
+
+TEMPLATE
+bool CLASS::get_block_size(size_t& out, const header_link& link,
+    bool witness) NOEXCEPT
+{
+    const auto fk = to_txs_link(link);
+    if (fk.is_terminal())
+        return false;
+
+    table::txs::slab txs{};
+    if (!store_.txs.get(fk, txs))
+        return false;
+
+    // Stored tx sizes allow exact block size without reading txs.
+    out = system::chain::header::serialized_size() +
+        system::variable_size(txs.tx_fks.size());
+
+    for (const auto& tx_fk: txs.tx_fks)
+    {
+        size_t size{};
+        if (!get_tx_size(size, tx_fk, witness))
+            return false;
+
+        out += size;
+    }
+
+    return true;
+}
+
+TEMPLATE
+bool CLASS::write_block(system::writer& sink, const header_link& link,
+    bool witness) NOEXCEPT
+{
+    const auto fk = to_txs_link(link);
+    if (fk.is_terminal())
+        return false;
+
+    table::txs::slab txs{};
+    if (!store_.txs.get(fk, txs) || !write_header(sink, link))
+        return false;
+
+    sink.write_variable(txs.tx_fks.size());
+    for (const auto& tx_fk: txs.tx_fks)
+        if (!write_transaction(sink, tx_fk, witness))
+            return false;
+
+    return sink;
+}
+
+// protected
+TEMPLATE
+bool CLASS::write_header(system::writer& sink,
+    const header_link& link) NOEXCEPT
+{
+    chain_header header{};
+    if (!get_cached_header(header, link))
+        return false;
+
+    // Terminal parent implies genesis (null previous block hash).
+    chain_header parent{};
+    if (!header.parent.is_terminal() &&
+        !get_cached_header(parent, header.parent))
+        return false;
+
+    sink.write_4_bytes_little_endian(header.version);
+    sink.write_bytes(parent.hash);
+    sink.write_bytes(header.merkle_root);
+    sink.write_4_bytes_little_endian(header.timestamp);
+    sink.write_4_bytes_little_endian(header.bits);
+    sink.write_4_bytes_little_endian(header.nonce);
+    return sink;
+}
+
+TEMPLATE
+bool CLASS::write_transaction(system::writer& sink, const tx_link& link,
+    bool witness) NOEXCEPT
+{
+    const table::transaction::view tx{ store_.tx.get_memory(link) };
+    if (!tx)
+        return false;
+
+    table::puts::record puts{};
+    puts.in_fks.resize(tx.ins_count());
+    puts.out_fks.resize(tx.outs_count());
+    if (!store_.puts.get(tx.ins_fk(), puts))
+        return false;
+
+    // Elements write directly to sink, with no allocation per input/output.
+    const auto point_key = [this](const point_link& point_fk) NOEXCEPT
+    {
+        return get_point_key(point_fk);
+    };
+
+    // Witness serialization differs only if the tx is segregated.
+    const auto segregated = witness && (tx.heavy() != tx.light());
+
+    sink.write_4_bytes_little_endian(tx.version());
+    if (segregated)
+    {
+        // BIP144 marker and flag.
+        sink.write_byte(0x00);
+        sink.write_byte(0x01);
+    }
+
+    sink.write_variable(puts.in_fks.size());
+    for (const auto& fk: puts.in_fks)
+    {
+        table::input::wire<decltype(point_key)> in{ {}, sink, point_key };
+        if (!store_.input.get(fk, in))
+            return false;
+    }
+
+    sink.write_variable(puts.out_fks.size());
+    for (const auto& fk: puts.out_fks)
+    {
+        table::output::wire out{ {}, sink };
+        if (!store_.output.get(fk, out))
+            return false;
+    }
+
+    if (segregated)
+    {
+        for (const auto& fk: puts.in_fks)
+        {
+            table::input::wire_witness in{ {}, sink };
+            if (!store_.input.get(fk, in))
+                return false;
+
+            table::witness::wire wit{ {}, sink };
+            if (in.is_external() && !store_.witness.get(in.witness_fk, wit))
+                return false;
+        }
+    }
+
+    sink.write_4_bytes_little_endian(tx.locktime());
+    return sink;
+}
+
 TEMPLATE
 typename CLASS::inputs_ptr CLASS::get_spenders(
     const output_link& link) NOEXCEPT
@@ -916,39 +1249,94 @@ tx_link CLASS::set_link(const transaction& tx) NOEXCEPT
     if (tx_fk.is_terminal())
         return {};
 
-    uint32_t input_index = 0;
-    linkage<schema::put> put_fk{};
+    // Empty witness is always stored inline.
+    std_vector<table::input::wx::integer> witness_fks{};
+    witness_fks.reserve(ins.size());
     for (const auto& in: ins)
     {
-        if (!store_.input.set_link(put_fk, table::input::slab_put_ref
-        {
-            {},
-            tx_fk,
-            input_index++,
-            *in
-        }))
+        auto witness_fk = table::input::wx::terminal;
+        if (store_.witness.enabled() && !in->witness().stack().empty())
         {
-            return {};
+            witness_fk = store_.witness.put_link(table::witness::slab_put_ref
+            {
+                {},
+                in->witness()
+            });
+
+            if (witness_fk == table::input::wx::terminal)
+                return {};
         }
 
-        puts.in_fks.push_back(put_fk);
+        witness_fks.push_back(witness_fk);
     }
 
-    uint32_t output_index = 0;
-    for (const auto& out: outs)
+    // Inputs and outputs of a tx are each allocated as one contiguous range,
+    // so tx reads are sequential and allocation contention is reduced. The
+    // puts records are retained because slabs are variable size, so the link
+    // of an indexed put (to_input/to_output) cannot be computed from the
+    // first link without reading every preceding slab.
+    const auto input_put = [&](uint32_t index) NOEXCEPT
     {
-        if (!store_.output.put_link(put_fk, table::output::slab_put_ref
+        return table::input::slab_put_ref
         {
             {},
             tx_fk,
-            output_index++,
-            *out
-        }))
+            index,
+            *ins.at(index),
+            witness_fks.at(index)
+        };
+    };
+
+    const auto output_put = [&](uint32_t index) NOEXCEPT
+    {
+        return table::output::slab_put_ref
         {
+            {},
+            tx_fk,
+            index,
+            *outs.at(index),
+            store_.output.compact()
+        };
+    };
+
+    // Slab sizes are computed once, as offsets into each range.
+    using put_link = linkage<schema::put>;
+    put_link::integer ins_size{};
+    for (uint32_t index = 0; index < ins.size(); ++index)
+    {
+        puts.in_fks.push_back(ins_size);
+        ins_size += input_put(index).count();
+    }
+
+    put_link::integer outs_size{};
+    for (uint32_t index = 0; index < outs.size(); ++index)
+    {
+        puts.out_fks.push_back(outs_size);
+        outs_size += output_put(index).count();
+    }
+
+    const auto ins_fk = store_.input.allocate(ins_size);
+    if (ins_fk.is_terminal())
+        return {};
+
+    for (uint32_t index = 0; index < ins.size(); ++index)
+    {
+        auto& put_fk = puts.in_fks.at(index);
+        put_fk += ins_fk;
+        if (!store_.input.set(put_fk, input_put(index)))
             return {};
-        }
+    }
+
+    const auto outs_fk = store_.output.allocate(outs_size);
+    if (outs_fk.is_terminal())
+        return {};
 
-        puts.out_fks.push_back(put_fk);
+    for (uint32_t index = 0; index < outs.size(); ++index)
+    {
+        auto& put_fk = puts.out_fks.at(index);
+        put_fk += outs_fk;
+        if (!store_.output.set(put_fk, output_put(index)))
+            return {};
     }
 
     const auto puts_fk = store_.puts.put_link(puts);
@@ -1049,7 +1437,16 @@ bool CLASS::set(const header_link& link, const tx_links& links) NOEXCEPT
     // ========================================================================
     const auto scope = store_.get_transactor();
 
-    return store_.txs.put(link, table::txs::slab{ {}, links });
+    if (!store_.txs.put(link, table::txs::slab
+    {
+        {},
+        links,
+        store_.txs.compact()
+    }))
+        return false;
+
+    set_associated(link);
+    return true;
     // ========================================================================
 }
 
@@ -1104,8 +1501,8 @@ inline bool CLASS::is_sufficient(const context& current,
 TEMPLATE
 bool CLASS::get_timestamp(uint32_t& timestamp, const header_link& link) NOEXCEPT
 {
-    table::header::get_timestamp header{};
-    if (!store_.header.get(link, header))
+    chain_header header{};
+    if (!get_cached_header(header, link))
         return false;
 
     timestamp = header.timestamp;
@@ -1115,8 +1512,8 @@ bool CLASS::get_timestamp(uint32_t& timestamp, const header_link& link) NOEXCEPT
 TEMPLATE
 bool CLASS::get_version(uint32_t& version, const header_link& link) NOEXCEPT
 {
-    table::header::get_version header{};
-    if (!store_.header.get(link, header))
+    chain_header header{};
+    if (!get_cached_header(header, link))
         return false;
 
     version = header.version;
@@ -1126,22 +1523,22 @@ bool CLASS::get_version(uint32_t& version, const header_link& link) NOEXCEPT
 TEMPLATE
 bool CLASS::get_bits(uint32_t& bits, const header_link& link) NOEXCEPT
 {
-    table::header::get_bits header{};
-    if (!store_.header.get(link, header))
+    chain_header header{};
+    if (!get_cached_header(header, link))
         return false;
 
-    bits = std::move(header.bits);
+    bits = header.bits;
     return true;
 }
 
 TEMPLATE
 bool CLASS::get_context(context& ctx, const header_link& link) NOEXCEPT
 {
-    table::header::record_context header{};
-    if (!store_.header.get(link, header))
+    chain_header header{};
+    if (!get_cached_header(header, link))
         return false;
 
-    ctx = std::move(header.ctx);
+    ctx = header.ctx;
     return true;
 }
 
@@ -1183,31 +1580,26 @@ code CLASS::get_block_state(uint64_t& fees, const header_link& link) NOEXCEPT
 TEMPLATE
 code CLASS::get_tx_state(const tx_link& link, const context& ctx) NOEXCEPT
 {
-    auto it = store_.validated_tx.it(link);
-    if (it.self().is_terminal())
-        return error::unvalidated;
-
-    table::validated_tx::slab_get_code valid{};
-    do
-    {
-        if (!store_.validated_tx.get(it.self(), valid))
-            return error::integrity;
-
-        if (is_sufficient(ctx, valid.ctx))
-            return to_tx_code(valid.code);
-    }
-    while (it.advance());
-    return error::unvalidated;
+    uint64_t fee{};
+    size_t sigops{};
+    return get_tx_state(fee, sigops, link, ctx);
 }
 
 TEMPLATE
 code CLASS::get_tx_state(uint64_t& fee, size_t& sigops, const tx_link& link,
     const context& ctx) NOEXCEPT
 {
+    refresh();
     auto it = store_.validated_tx.it(link);
-    if (it.self().is_terminal())
+    const auto head = it.self();
+    if (head.is_terminal())
         return error::unvalidated;
 
+    // Any write replaces the head, so a result cached for it is current.
+    code ec{};
+    if (get_cached_tx_state(ec, fee, sigops, link, head, ctx))
+        return ec;
+
     table::validated_tx::slab valid{};
     do
     {
@@ -1216,15 +1608,107 @@ code CLASS::get_tx_state(uint64_t& fee, size_t& sigops, const tx_link& link,
 
         if (is_sufficient(ctx, valid.ctx))
         {
+            set_cached_tx_state(link, head, ctx, &valid);
             fee = valid.fee;
             sigops = valid.sigops;
             return to_tx_code(valid.code);
         }
     }
     while (it.advance());
+
+    set_cached_tx_state(link, head, ctx, nullptr);
     return error::unvalidated;
 }
 
+// protected
+TEMPLATE
+bool CLASS::get_cached_tx_state(code& ec, uint64_t& fee, size_t& sigops,
+    const tx_link& link, const table::validated_tx::link& head,
+    const context& ctx) NOEXCEPT
+{
+    // Fields are read between two equal even sequences, or the read is a miss.
+    const auto& slot = tx_states_.at(link.value % cached_tx_states);
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (is_odd(sequence))
+        return false;
+
+    const auto hit =
+        slot.tx.load(std::memory_order_relaxed) == link.value &&
+        slot.head.load(std::memory_order_relaxed) == head.value &&
+        slot.flags.load(std::memory_order_relaxed) == ctx.flags &&
+        slot.height.load(std::memory_order_relaxed) == ctx.height &&
+        slot.mtp.load(std::memory_order_relaxed) == ctx.mtp;
+    const auto validated = slot.validated.load(std::memory_order_relaxed);
+    const auto value = slot.code.load(std::memory_order_relaxed);
+    const auto fees = slot.fee.load(std::memory_order_relaxed);
+    const auto sigs = slot.sigops.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!hit || slot.sequence.load(std::memory_order_relaxed) != sequence)
+        return false;
+
+    if (!validated)
+    {
+        ec = error::unvalidated;
+        return true;
+    }
+
+    fee = fees;
+    sigops = sigs;
+    ec = to_tx_code(value);
+    return true;
+}
+
+// protected
+TEMPLATE
+void CLASS::set_cached_tx_state(const tx_link& link,
+    const table::validated_tx::link& head, const context& ctx,
+    const table::validated_tx::slab* state) NOEXCEPT
+{
+    // A slot held by another writer is left to it (the result is not cached).
+    auto& slot = tx_states_.at(link.value % cached_tx_states);
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    if (is_odd(sequence) || !slot.sequence.compare_exchange_strong(sequence,
+        add1(sequence), std::memory_order_acquire))
+        return;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.tx.store(link.value, std::memory_order_relaxed);
+    slot.head.store(head.value, std::memory_order_relaxed);
+    slot.flags.store(ctx.flags, std::memory_order_relaxed);
+    slot.height.store(ctx.height, std::memory_order_relaxed);
+    slot.mtp.store(ctx.mtp, std::memory_order_relaxed);
+    slot.validated.store(!is_null(state), std::memory_order_relaxed);
+    slot.code.store(is_null(state) ? 0 : state->code,
+        std::memory_order_relaxed);
+    slot.fee.store(is_null(state) ? 0 : state->fee,
+        std::memory_order_relaxed);
+    slot.sigops.store(is_null(state) ? 0 : state->sigops,
+        std::memory_order_relaxed);
+    slot.sequence.store(sequence + two, std::memory_order_release);
+}
+
+// protected
+TEMPLATE
+bool CLASS::is_tx_state(const tx_link& link,
+    const table::validated_tx::slab& state) NOEXCEPT
+{
+    // A written state becomes the chain head, so it is implied only by a head
+    // of equal result that is sufficient for its context. Sufficiency is
+    // transitive, so that head is found first by any context the state would
+    // satisfy. A matching state below the head may be preceded by another.
+    const auto head = store_.validated_tx.first(link);
+    if (head.is_terminal())
+        return false;
+
+    table::validated_tx::slab valid{};
+    return store_.validated_tx.get(head, valid)
+        && is_sufficient(state.ctx, valid.ctx)
+        && valid.code == state.code
+        && valid.fee == state.fee
+        && valid.sigops == state.sigops;
+}
+
 TEMPLATE
 bool CLASS::set_block_preconfirmable(const header_link& link) NOEXCEPT
 {
@@ -1275,17 +1759,22 @@ TEMPLATE
 bool CLASS::set_tx_preconnected(const tx_link& link,
     const context& ctx) NOEXCEPT
 {
-    // ========================================================================
-    const auto scope = store_.get_transactor();
-
-    return store_.validated_tx.put(link, table::validated_tx::slab
+    const table::validated_tx::slab state
     {
         {},
         ctx,
         schema::tx_state::preconnected,
         0, // fee
         0  // sigops
-    });
+    };
+
+    if (is_tx_state(link, state))
+        return true;
+
+    // ========================================================================
+    const auto scope = store_.get_transactor();
+
+    return store_.validated_tx.put(link, state);
     // ========================================================================
 }
 
@@ -1296,17 +1785,22 @@ bool CLASS::set_tx_connected(const tx_link& link, const context& ctx,
     using sigs = linkage<schema::sigops>;
     BC_ASSERT(sigops < system::power2<sigs::integer>(to_bits(sigs::size)));
 
-    // ========================================================================
-    const auto scope = store_.get_transactor();
-
-    return store_.validated_tx.put(link, table::validated_tx::slab
+    const table::validated_tx::slab state
     {
         {},
         ctx,
         schema::tx_state::connected,
         fee,
         system::possible_narrow_cast<sigs::integer>(sigops)
-    });
+    };
+
+    if (is_tx_state(link, state))
+        return true;
+
+    // ========================================================================
+    const auto scope = store_.get_transactor();
+
+    return store_.validated_tx.put(link, state);
     // ========================================================================
 }
 
@@ -1314,17 +1808,22 @@ TEMPLATE
 bool CLASS::set_tx_disconnected(const tx_link& link,
     const context& ctx) NOEXCEPT
 {
-    // ========================================================================
-    const auto scope = store_.get_transactor();
-
-    return store_.validated_tx.put(link, table::validated_tx::slab
+    const table::validated_tx::slab state
     {
         {},
         ctx,
         schema::tx_state::disconnected,
         0, // fee
         0  // sigops
-    });
+    };
+
+    if (is_tx_state(link, state))
+        return true;
+
+    // ========================================================================
+    const auto scope = store_.get_transactor();
+
+    return store_.validated_tx.put(link, state);
     // ========================================================================
 }
 
@@ -1336,11 +1835,11 @@ bool CLASS::set_tx_disconnected(const tx_link& link,
 TEMPLATE
 height_link CLASS::get_height(const header_link& link) NOEXCEPT
 {
-    table::header::record_height header{};
-    if (!store_.header.get(link, header))
+    const table::header::view header{ store_.header.get_memory(link) };
+    if (!header)
         return {};
 
-    return header.height;
+    return header.height();
 }
 
 TEMPLATE
@@ -1350,9 +1849,8 @@ bool CLASS::is_candidate_block(const header_link& link) NOEXCEPT
     if (height.is_terminal())
         return false;
 
-    table::height::record candidate{};
-    return store_.candidate.get(height, candidate) &&
-        (candidate.header_fk == link);
+    const table::height::view candidate{ store_.candidate.get_memory(height) };
+    return candidate && (candidate.header_fk() == link);
 }
 
 TEMPLATE
@@ -1362,9 +1860,8 @@ bool CLASS::is_confirmed_block(const header_link& link) NOEXCEPT
     if (height.is_terminal())
         return false;
 
-    table::height::record confirmed{};
-    return store_.confirmed.get(height, confirmed) &&
-        (confirmed.header_fk == link);
+    const table::height::view confirmed{ store_.confirmed.get_memory(height) };
+    return confirmed && (confirmed.header_fk() == link);
 }
 
 TEMPLATE
@@ -1593,20 +2090,80 @@ bool CLASS::pop_candidate() NOEXCEPT
     // ========================================================================
 }
 
-// Address (natural-keyed).
+// Chain headers (height-indexed).
 // ----------------------------------------------------------------------------
-// TODO: use point keys (for multimap compression).
+// Header records are immutable, so decoded headers are cached by link without
+// synchronization against the height indexes, and are populated only on read.
+
+TEMPLATE
+bool CLASS::get_candidate_header(chain_header& out, size_t height) NOEXCEPT
+{
+    return get_chain_header(out, height, true);
+}
 
 TEMPLATE
-hash_digest CLASS::address_hash(const output& output) NOEXCEPT
+bool CLASS::get_confirmed_header(chain_header& out, size_t height) NOEXCEPT
+{
+    return get_chain_header(out, height, false);
+}
+
+// protected
+TEMPLATE
+bool CLASS::get_chain_header(chain_header& out, size_t height,
+    bool candidate) NOEXCEPT
+{
+    const auto link = candidate ? to_candidate(height) : to_confirmed(height);
+    return !link.is_terminal() && get_cached_header(out, link);
+}
+
+// protected
+TEMPLATE
+bool CLASS::get_cached_header(chain_header& out,
+    const header_link& link) NOEXCEPT
 {
-    hash_digest digest{};
-    system::hash::sha256::copy sink(digest);
-    output.to_data(sink);
-    sink.flush();
-    return digest;
+    refresh();
+
+    {
+        std::shared_lock lock{ headers_mutex_ };
+        const auto it = headers_.find(link);
+        if (it != headers_.end())
+        {
+            out = it->second;
+            return true;
+        }
+    }
+
+    // The view is released before the key read, as each holds a shared
+    // lock on header memory (which would stall against a waiting remap).
+    {
+        const table::header::view header{ store_.header.get_memory(link) };
+        if (!header)
+            return false;
+
+        out.link = link;
+        out.parent = header.parent_fk();
+        out.merkle_root = header.merkle_root();
+        out.ctx = header.ctx();
+        out.version = header.version();
+        out.timestamp = header.timestamp();
+        out.bits = header.bits();
+        out.nonce = header.nonce();
+    }
+
+    out.hash = get_header_key(link);
+
+    std::unique_lock lock{ headers_mutex_ };
+    if (headers_.size() >= cached_headers)
+        headers_.clear();
+
+    headers_.emplace(link, out);
+    return true;
 }
 
+// Address (natural-keyed).
+// ----------------------------------------------------------------------------
+// Address keys are short script ids, so each output script is compared.
+
 // protected
 TEMPLATE
 bool CLASS::is_confirmed_unspent(const output_link& link) NOEXCEPT
@@ -1617,39 +2174,41 @@ bool CLASS::is_confirmed_unspent(const output_link& link) NOEXCEPT
 // TODO: test more.
 TEMPLATE
 bool CLASS::get_confirmed_balance(uint64_t& out,
-    const hash_digest& key) NOEXCEPT
+    const script& script) NOEXCEPT
 {
-    auto it = store_.address.it(key);
-    if (it.self().is_terminal())
+    size_t count{};
+    if (get_cached_balance(out, count, script))
+        return true;
+
+    output_links outputs{};
+    if (!to_address_outputs(outputs, script))
         return false;
 
     out = zero;
-    do
+    for (const auto& fk: outputs)
     {
-        table::address::record address{};
-        if (!store_.address.get(it.self(), address))
-            return false;
-
         // Failure or overflow returns maximum value.
-        if (is_confirmed_unspent(address.output_fk))
+        if (is_confirmed_unspent(fk))
         {
             uint64_t value{};
-            if (!get_value(value, address.output_fk))
+            if (!get_value(value, fk))
                 return false;
 
             out = system::ceilinged_add(value, out);
         }
     }
-    while (it.advance());
+
     return true;
 }
 
 // TODO: test more.
 TEMPLATE
 bool CLASS::to_address_outputs(output_links& out,
-    const hash_digest& key) NOEXCEPT
+    const script& script) NOEXCEPT
 {
-    auto it = store_.address.it(key);
+    // Key and compare in compressed form, avoiding script deserialization.
+    const auto compressed = compression::script_to_data(script);
+    auto it = store_.address.it(store_.address.script_id(compressed));
     if (it.self().is_terminal())
         return false;
 
@@ -1657,97 +2216,722 @@ bool CLASS::to_address_outputs(output_links& out,
     do
     {
         table::address::record address{};
-        if (!store_.address.get(it.self(), address))
+        table::output::get_script_match output{ {}, compressed };
+        if (!store_.address.get(it.self(), address) ||
+            !store_.output.get(address.output_fk, output))
         {
             out.clear();
             return false;
         }
 
-        out.push_back(address.output_fk);
+        // Excludes script id collisions.
+        if (output.match)
+            out.push_back(address.output_fk);
     }
     while (it.advance());
-    return true;
+
+    // A tx confirmed in more than one branch, or an indexing batch repeated
+    // after a fault, produces duplicate rows (record hashmap is append-only).
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return !out.empty();
 }
 
-// TODO: test more.
 TEMPLATE
-bool CLASS::to_unspent_outputs(output_links& out,
-    const hash_digest& key) NOEXCEPT
+bool CLASS::to_address_page(output_links& out, address_link& cursor,
+    const script& script, size_t limit, size_t minimum,
+    size_t maximum) NOEXCEPT
 {
-    auto it = store_.address.it(key);
+    out.clear();
+
+    // Key and compare in compressed form, avoiding script deserialization.
+    const auto compressed = compression::script_to_data(script);
+    const auto key = store_.address.script_id(compressed);
+    auto it = cursor.is_terminal() ? store_.address.it(key) :
+        store_.address.it(key, cursor);
+
+    cursor = {};
     if (it.self().is_terminal())
-        return {};
+        return true;
+
+    const auto filter = !is_zero(minimum) || maximum != max_size_t;
 
-    out.clear();
     do
     {
+        if (out.size() >= limit)
+        {
+            cursor = it.self();
+            return true;
+        }
+
         table::address::record address{};
-        if (!store_.address.get(it.self(), address))
+        table::output::get_script_match output{ {}, compressed };
+        if (!store_.address.get(it.self(), address) ||
+            !store_.output.get(address.output_fk, output))
         {
             out.clear();
             return false;
         }
 
-        if (is_confirmed_unspent(address.output_fk))
-            out.push_back(address.output_fk);
+        // Excludes script id collisions.
+        if (!output.match)
+            continue;
+
+        // Height filter excludes unconfirmed outputs.
+        size_t height{};
+        if (filter && (!get_address_height(height, address) ||
+            height < minimum || height > maximum))
+            continue;
+
+        out.push_back(address.output_fk);
     }
     while (it.advance());
     return true;
 }
 
-// TODO: test more.
 TEMPLATE
-bool CLASS::to_minimum_unspent_outputs(output_links& out,
-    const hash_digest& key, uint64_t minimum) NOEXCEPT
+bool CLASS::to_address_history(output_links& out, const script& script,
+    size_t minimum, size_t maximum) NOEXCEPT
 {
-    auto it = store_.address.it(key);
+    out.clear();
+
+    // Key and compare in compressed form, avoiding script deserialization.
+    const auto compressed = compression::script_to_data(script);
+    auto it = store_.address.it(store_.address.script_id(compressed));
     if (it.self().is_terminal())
-        return {};
+        return true;
 
-    out.clear();
+    using entry = std::pair<size_t, output_link::integer>;
+    std_vector<entry> history{};
     do
     {
         table::address::record address{};
         if (!store_.address.get(it.self(), address))
-            return {};
+            return false;
 
-        // Confirmed and not spent, but possibly immature.
-        if (is_confirmed_output(address.output_fk) &&
-            !is_spent_output(address.output_fk))
-        {
-            uint64_t value{};
-            if (!get_value(value, address.output_fk))
-            {
-                out.clear();
-                return false;
-            }
+        // Stored height avoids per-element height resolution.
+        size_t height{};
+        if (!get_address_height(height, address) ||
+            height < minimum || height > maximum)
+            continue;
 
-            if (value >= minimum)
-                out.push_back(address.output_fk);
-        }
+        table::output::get_script_match output{ {}, compressed };
+        if (!store_.output.get(address.output_fk, output))
+            return false;
+
+        // Excludes script id collisions.
+        if (output.match)
+            history.emplace_back(height, address.output_fk);
     }
     while (it.advance());
+
+    // Chain order is reverse of insertion, so sort by height (then output).
+    std::sort(history.begin(), history.end());
+    history.erase(std::unique(history.begin(), history.end()), history.end());
+
+    out.reserve(history.size());
+    for (const auto& item: history)
+        out.push_back(item.second);
+
+    return true;
+}
+
+// TODO: test more.
+TEMPLATE
+bool CLASS::to_unspent_outputs(output_links& out,
+    const script& script) NOEXCEPT
+{
+    output_links outputs{};
+    if (!to_address_outputs(outputs, script))
+        return false;
+
+    out.clear();
+    for (const auto& fk: outputs)
+        if (is_confirmed_unspent(fk))
+            out.push_back(fk);
+
+    return true;
+}
+
+// TODO: test more.
+TEMPLATE
+bool CLASS::to_minimum_unspent_outputs(output_links& out,
+    const script& script, uint64_t minimum) NOEXCEPT
+{
+    const auto coins = get_coins(script);
+    if (!coins)
+        return false;
+
+    // Ascending by value, from the first sufficient coin.
+    out.clear();
+    const auto first = std::lower_bound(coins->begin(), coins->end(), minimum,
+        [](const coin& left, uint64_t right) NOEXCEPT
+        {
+            return left.first < right;
+        });
+
+    for (auto it = first; it != coins->end(); ++it)
+        out.push_back(it->second);
+
     return true;
 }
 
 TEMPLATE
-bool CLASS::set_address_output(const hash_digest& key,
+bool CLASS::to_largest_unspent_outputs(output_links& out,
+    const script& script, size_t count) NOEXCEPT
+{
+    const auto coins = get_coins(script);
+    if (!coins)
+        return false;
+
+    // Descending by value, at most count coins.
+    out.clear();
+    out.reserve(std::min(count, coins->size()));
+    for (auto it = coins->rbegin(); it != coins->rend() &&
+        out.size() < count; ++it)
+        out.push_back(it->second);
+
+    return true;
+}
+
+TEMPLATE
+bool CLASS::to_sufficient_unspent_output(output_link& out,
+    const script& script, uint64_t value) NOEXCEPT
+{
+    const auto coins = get_coins(script);
+    if (!coins)
+        return false;
+
+    // Smallest coin of at least value, or terminal.
+    const auto it = std::lower_bound(coins->begin(), coins->end(), value,
+        [](const coin& left, uint64_t right) NOEXCEPT
+        {
+            return left.first < right;
+        });
+
+    out = it == coins->end() ? output_link{} : output_link{ it->second };
+    return true;
+}
+
+// protected
+TEMPLATE
+typename CLASS::coins_cptr CLASS::get_coins(const script& script) NOEXCEPT
+{
+    // Spentness and confirmation change only with the confirmed chain, and
+    // outputs are added by address rows, which may follow the chain.
+    const size_t rows = store_.address.count();
+    const size_t count = store_.confirmed.count();
+    const auto top = is_zero(count) ? header_link{} : to_confirmed(sub1(count));
+    const auto data = script.to_data(false);
+    refresh();
+
+    {
+        std::shared_lock lock{ coins_mutex_ };
+        if (coins_rows_ == rows && coins_count_ == count && coins_top_ == top)
+        {
+            const auto it = coins_.find(data);
+            if (it != coins_.end())
+                return it->second;
+        }
+    }
+
+    output_links outputs{};
+    if (!to_unspent_outputs(outputs, script))
+        return {};
+
+    // Confirmed and not spent, but possibly immature.
+    const auto sorted = std::make_shared<coins>();
+    sorted->reserve(outputs.size());
+    for (const auto& fk: outputs)
+    {
+        uint64_t value{};
+        if (!get_value(value, fk))
+            return {};
+
+        sorted->emplace_back(value, fk);
+    }
+
+    std::sort(sorted->begin(), sorted->end());
+
+    {
+        std::unique_lock lock{ coins_mutex_ };
+        if (coins_rows_ != rows || coins_count_ != count ||
+            coins_top_ != top || coins_.size() >= coin_scripts)
+        {
+            coins_.clear();
+            coins_rows_ = rows;
+            coins_count_ = count;
+            coins_top_ = top;
+        }
+
+        coins_.insert_or_assign(data, sorted);
+    }
+
+    return sorted;
+}
+
+TEMPLATE
+bool CLASS::set_address_output(const script& script,
     const output_link& link) NOEXCEPT
 {
     if (link.is_terminal())
         return false;
 
+    // Stored heights are owned by the indexer, which writes them in height
+    // order. This row is unconfirmed, and its height is resolved on read.
+    const auto key = store_.address.script_id(script);
+
     // ========================================================================
     const auto scope = store_.get_transactor();
 
     return store_.address.put(key, table::address::record
     {
         {},
-        link
+        link,
+        table::address::block::terminal
     });
     // ========================================================================
 }
 
+// protected
+TEMPLATE
+bool CLASS::get_address_height(size_t& out,
+    const table::address::record& address) NOEXCEPT
+{
+    if (address.is_confirmed())
+    {
+        out = address.height;
+        return true;
+    }
+
+    // Rows written by set_address_output, or popped by the indexer, are
+    // resolved from the tx, so they reflect its current confirmation.
+    return get_tx_height(out, to_output_tx(address.output_fk));
+}
+
+TEMPLATE
+size_t CLASS::get_address_checkpoint() NOEXCEPT
+{
+    return store_.indexed.count();
+}
+
+TEMPLATE
+bool CLASS::get_cached_balance(uint64_t& value, size_t& outputs,
+    const script& script) NOEXCEPT
+{
+    // The cache reflects the indexed blocks, so is current only at the top.
+    const auto count = get_address_checkpoint();
+    if (count != store_.confirmed.count())
+        return false;
+
+    // Equal counts after a reorganization may not yet be unindexed.
+    if (!is_zero(count))
+    {
+        const auto height = sub1(count);
+        table::height::record indexed{};
+        if (!store_.indexed.get(system::possible_narrow_cast<
+            height_link::integer>(height), indexed) ||
+            indexed.header_fk != to_confirmed(height))
+            return false;
+    }
+
+    table::balance::record balance{};
+    const auto compressed = compression::script_to_data(script);
+    const auto key = store_.address.script_id(compressed);
+    if (!store_.balance.get(store_.balance.first(key), balance) ||
+        balance.is_collided())
+        return false;
+
+    // Excludes a script id collision with the cached script.
+    table::output::get_script_match output{ {}, compressed };
+    if (!store_.output.get(balance.output_fk, output) || !output.match)
+        return false;
+
+    value = balance.value;
+    outputs = balance.outputs;
+    return true;
+}
+
+TEMPLATE
+bool CLASS::index_addresses(size_t& indexed, size_t limit) NOEXCEPT
+{
+    // Balance deltas are applied in place, so a batch must be built and
+    // applied (and the checkpoint advanced) by one indexer at a time.
+    const auto lock = store_.get_indexer();
+
+    indexed = zero;
+    if (!unindex_addresses())
+        return false;
+
+    // Index confirmed blocks above the checkpoint, up to limit blocks.
+    const auto start = get_address_checkpoint();
+    const auto end = std::min<size_t>(store_.confirmed.count(),
+        system::ceilinged_add(start, limit));
+    if (start >= end)
+        return true;
+
+    header_links blocks{};
+    blocks.reserve(end - start);
+    for (auto height = start; height < end; ++height)
+        blocks.push_back(to_confirmed(height));
+
+    address_puts created{};
+    address_puts spent{};
+    if (!get_address_puts(created, spent, blocks))
+        return false;
+
+    // ========================================================================
+    const auto scope = store_.get_transactor();
+
+    // Allocate the batch at once, then set and commit each record into it.
+    const auto first = store_.address.allocate(created.links.size());
+    if (first.is_terminal())
+        return false;
+
+    for (size_t index = zero; index < created.links.size(); ++index)
+    {
+        const auto link = system::possible_narrow_cast<
+            address_link::integer>(first + index);
+        if (!store_.address.put(link, created.keys.at(index),
+            table::address::record
+            {
+                {},
+                created.links.at(index),
+                created.heights.at(index)
+            }))
+            return false;
+    }
+
+    // Balance deltas cannot be reapplied by a retry, so a fault in applying
+    // them (or in advancing the checkpoint) invalidates the batch's keys.
+    if (!set_balances(created, spent, true))
+    {
+        /* bool */ set_collided(created, spent);
+        return false;
+    }
+
+    // Advance the checkpoint in one allocation, after balances are applied.
+    const auto base = store_.indexed.allocate(blocks.size());
+    if (base.is_terminal())
+    {
+        /* bool */ set_collided(created, spent);
+        return false;
+    }
+
+    for (size_t index = zero; index < blocks.size(); ++index)
+    {
+        const auto link = system::possible_narrow_cast<
+            height_link::integer>(base + index);
+        if (!store_.indexed.set(link, table::height::record
+            {
+                {},
+                blocks.at(index)
+            }))
+        {
+            /* bool */ set_collided(created, spent);
+            return false;
+        }
+    }
+
+    indexed = blocks.size();
+    return true;
+    // ========================================================================
+}
+
+// protected
+TEMPLATE
+bool CLASS::unindex_addresses() NOEXCEPT
+{
+    // Rewind the checkpoint to the confirmed chain (address rows remain).
+    const auto top = get_address_checkpoint();
+    auto checkpoint = top;
+    header_links blocks{};
+    while (!is_zero(checkpoint))
+    {
+        const auto height = sub1(checkpoint);
+        const auto link = system::possible_narrow_cast<height_link::integer>(height);
+
+        table::height::record indexed{};
+        if (!store_.indexed.get(link, indexed))
+            return false;
+
+        if (indexed.header_fk == to_confirmed(height))
+            break;
+
+        blocks.push_back(indexed.header_fk);
+        --checkpoint;
+    }
+
+    if (checkpoint == top)
+        return true;
+
+    // Popped blocks remain archived, so their balance changes are reversed.
+    address_puts created{};
+    address_puts spent{};
+    if (!get_address_puts(created, spent, blocks))
+        return false;
+
+    // ========================================================================
+    const auto scope = store_.get_transactor();
+
+    if (set_balances(created, spent, false) && set_unconfirmed(created) &&
+        store_.indexed.truncate(system::possible_narrow_cast<
+            height_link::integer>(checkpoint)))
+        return true;
+
+    /* bool */ set_collided(created, spent);
+    return false;
+    // ========================================================================
+}
+
+// protected
+TEMPLATE
+bool CLASS::set_unconfirmed(const address_puts& popped) NOEXCEPT
+{
+    // Rows of popped outputs no longer carry a confirmed height. Popped rows
+    // of a key are found in one walk of its chain, which is newest first.
+    // Only the indexer stores heights, in ascending order, so the walk ends
+    // at the first confirmed row below the lowest popped height, as no older
+    // row can be popped. Walk length is bounded by rows at or above the fork.
+    using block = table::address::block;
+    using target = std::pair<output_link::integer, block::integer>;
+    std::map<table::address::key, std_vector<target>> keys{};
+    for (size_t index = zero; index < popped.links.size(); ++index)
+        keys[popped.keys.at(index)].emplace_back(popped.links.at(index),
+            popped.heights.at(index));
+
+    for (auto& [key, targets]: keys)
+    {
+        auto it = store_.address.it(key);
+        if (it.self().is_terminal())
+            return false;
+
+        const auto lowest = std::min_element(targets.begin(), targets.end(),
+            [](const target& left, const target& right) NOEXCEPT
+            {
+                return left.second < right.second;
+            })->second;
+
+        do
+        {
+            table::address::record address{};
+            if (!store_.address.get(it.self(), address))
+                return false;
+
+            if (address.is_confirmed() && address.height < lowest)
+                break;
+
+            const auto found = std::find(targets.begin(), targets.end(),
+                target{ address.output_fk, address.height });
+            if (found == targets.end())
+                continue;
+
+            address.height = block::terminal;
+            if (!store_.address.set(it.self(), address))
+                return false;
+        }
+        while (it.advance());
+    }
+
+    return true;
+}
+
+// protected
+TEMPLATE
+bool CLASS::set_collided(const address_puts& created,
+    const address_puts& spent) NOEXCEPT
+{
+    // Collided is a terminal state, so these keys revert to history scans.
+    const auto invalidate = [&](const address_puts& puts) NOEXCEPT
+    {
+        for (const auto& key: puts.keys)
+        {
+            const auto link = store_.balance.first(key);
+            if (link.is_terminal())
+                continue;
+
+            table::balance::record balance{};
+            if (!store_.balance.get(link, balance))
+                return false;
+
+            balance.output_fk = table::balance::out::terminal;
+            if (!store_.balance.set(link, balance))
+                return false;
+        }
+
+        return true;
+    };
+
+    return invalidate(created) && invalidate(spent);
+}
+
+// protected
+TEMPLATE
+bool CLASS::get_address_puts(address_puts& created, address_puts& spent,
+    const header_links& blocks) NOEXCEPT
+{
+    for (const auto& header_fk: blocks)
+    {
+        const auto height = get_height(header_fk);
+        const auto outputs = to_block_outputs(header_fk);
+        if (height.is_terminal() || outputs.empty())
+            return false;
+
+        created.links.insert(created.links.end(), outputs.begin(),
+            outputs.end());
+        created.heights.insert(created.heights.end(), outputs.size(),
+            height);
+
+        // Null and missing prevouts do not affect any balance.
+        for (const auto& in: to_block_inputs(header_fk))
+        {
+            const auto prevout = to_prevout(in);
+            if (!prevout.is_terminal())
+                spent.links.push_back(prevout);
+        }
+    }
+
+    return get_address_puts(created) && get_address_puts(spent);
+}
+
+// protected
+TEMPLATE
+bool CLASS::get_address_puts(address_puts& puts) NOEXCEPT
+{
+    puts.values.clear();
+    puts.scripts.clear();
+    puts.keys.clear();
+    puts.values.reserve(puts.links.size());
+    puts.scripts.reserve(puts.links.size());
+    puts.keys.reserve(puts.links.size());
+
+    // Output links of a block batch are scattered across the body, so each
+    // read is preceded by a prefetch a fixed distance ahead of it.
+    const auto& links = puts.links;
+    const auto ahead = std::min(prefetched_outputs, links.size());
+    for (size_t index = 0; index < ahead; ++index)
+        store_.output.prefetch(links.at(index));
+
+    for (size_t index = 0; index < links.size(); ++index)
+    {
+        if (const auto next = index + ahead; next < links.size())
+            store_.output.prefetch(links.at(next));
+
+        // The script id is hashed from stored bytes (script is not parsed).
+        table::output::get_compressed output{};
+        if (!store_.output.get(links.at(index), output))
+            return false;
+
+        puts.keys.push_back(store_.address.script_id(output.script));
+        puts.values.push_back(output.value);
+        puts.scripts.push_back(std::move(output.script));
+    }
+
+    return true;
+}
+
+// protected
+TEMPLATE
+bool CLASS::set_balances(const address_puts& created,
+    const address_puts& spent, bool confirm) NOEXCEPT
+{
+    struct change
+    {
+        output_link::integer output_fk{};
+        const system::data_chunk* script{};
+        uint64_t added{};
+        uint64_t removed{};
+        uint32_t adds{};
+        uint32_t removes{};
+        bool collided{};
+    };
+
+    // Aggregate changes by key, identifying the first script of each key.
+    std::map<table::address::key, change> changes{};
+    const auto aggregate = [&](const address_puts& puts, bool add) NOEXCEPT
+    {
+        for (size_t index = zero; index < puts.links.size(); ++index)
+        {
+            // Compressed scripts are equal only if scripts are equal.
+            const auto& script = puts.scripts.at(index);
+            const auto value = puts.values.at(index);
+            auto& item = changes[puts.keys.at(index)];
+            if (is_null(item.script))
+            {
+                item.output_fk = puts.links.at(index);
+                item.script = &script;
+            }
+            else if (*item.script != script)
+            {
+                item.collided = true;
+            }
+
+            if (add)
+            {
+                item.added = system::ceilinged_add(item.added, value);
+                ++item.adds;
+            }
+            else
+            {
+                item.removed = system::ceilinged_add(item.removed, value);
+                ++item.removes;
+            }
+        }
+    };
+
+    // Popping a block reverses its outputs and spends.
+    aggregate(created, confirm);
+    aggregate(spent, !confirm);
+
+    using namespace system;
+    constexpr auto collided = table::balance::out::terminal;
+    for (const auto& [key, item]: changes)
+    {
+        table::balance::record balance{};
+        const auto link = store_.balance.first(key);
+        if (link.is_terminal())
+        {
+            balance.output_fk = item.collided ? collided : item.output_fk;
+            balance.value = floored_subtract(item.added, item.removed);
+            balance.outputs = floored_subtract(item.adds, item.removes);
+            if (!store_.balance.put(key, balance))
+                return false;
+
+            continue;
+        }
+
+        if (!store_.balance.get(link, balance))
+            return false;
+
+        // A distinct script with the same id invalidates the cached key.
+        if (item.collided)
+        {
+            balance.output_fk = collided;
+        }
+        else if (!balance.is_collided() && balance.output_fk != item.output_fk)
+        {
+            table::output::get_script_match output{ {}, *item.script };
+            if (!store_.output.get(balance.output_fk, output))
+                return false;
+
+            if (!output.match)
+                balance.output_fk = collided;
+        }
+
+        // Add before subtract, as spends may follow outputs in the batch.
+        balance.value = floored_subtract(ceilinged_add(balance.value,
+            item.added), item.removed);
+        balance.outputs = floored_subtract(ceilinged_add(balance.outputs,
+            item.adds), item.removes);
+
+        // Updated in place (record size is fixed).
+        if (!store_.balance.set(link, balance))
+            return false;
+    }
+
+    return true;
+}
+
 // Neutrino (surrogate-keyed).
 // ----------------------------------------------------------------------------
 
@@ -1789,6 +2973,54 @@ bool CLASS::set_filter(const header_link& link, const hash_digest& filter_head,
     // ========================================================================
 }
 
+TEMPLATE
+bool CLASS::get_filters(size_t height, size_t count,
+    const filter_handler& handler) NOEXCEPT
+{
+    const auto end = system::ceilinged_add(height, count);
+    for (auto index = height; index < end; ++index)
+    {
+        const auto header_fk = to_confirmed(index);
+        if (header_fk.is_terminal())
+            return false;
+
+        // The view holds a shared lock on neutrino memory until it goes out
+        // of scope, so all lookups precede it and it ends with the iteration.
+        const auto link = store_.neutrino.first(header_fk);
+        table::neutrino::view view{};
+        if (!store_.neutrino.get_view(view, link))
+            return false;
+
+        if (!handler(index, view.filter_head, view.filter))
+            return true;
+    }
+
+    return true;
+}
+
+TEMPLATE
+bool CLASS::get_filter_heads(hashes& out, size_t height, size_t count) NOEXCEPT
+{
+    // Filter heads are persisted with each filter, so the getcfheaders chain
+    // is read directly (32 bytes per block) without touching filter bodies.
+    out.clear();
+    const auto end = system::ceilinged_add(height, count);
+    for (auto index = height; index < end; ++index)
+    {
+        const auto header_fk = to_confirmed(index);
+        if (header_fk.is_terminal())
+            return false;
+
+        table::neutrino::slab_get_head neutrino{};
+        if (!store_.neutrino.get(store_.neutrino.first(header_fk), neutrino))
+            return false;
+
+        out.push_back(std::move(neutrino.filter_head));
+    }
+
+    return true;
+}
+
 // Buffer (surrogate-keyed).
 // ----------------------------------------------------------------------------
 // TODO: serialize prevouts, compare deserialization time to native storage.
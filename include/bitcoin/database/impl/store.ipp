@@ -19,6 +19,9 @@
 #ifndef LIBBITCOIN_DATABASE_STORE_IPP
 #define LIBBITCOIN_DATABASE_STORE_IPP
 
+#include <algorithm>
+#include <iterator>
+#include <random>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/boost.hpp>
 #include <bitcoin/database/define.hpp>
@@ -43,73 +46,104 @@ CLASS::store(const settings& config) NOEXCEPT
     // Archive.
 
     header_head_(head(config.path / schema::dir::heads, schema::archive::header)),
-    header_body_(body(config.path, schema::archive::header), config.header_size, config.header_rate),
+    header_body_(body(config.path, schema::archive::header), config.header_size, config.header_rate,
+        config.preallocate, config.preallocate_ahead),
     header(header_head_, header_body_, config.header_buckets),
 
     point_head_(head(config.path / schema::dir::heads, schema::archive::point)),
-    point_body_(body(config.path, schema::archive::point), config.point_size, config.point_rate),
+    point_body_(body(config.path, schema::archive::point), config.point_size, config.point_rate,
+        config.preallocate, config.preallocate_ahead),
     point(point_head_, point_body_, config.point_buckets),
 
     input_head_(head(config.path / schema::dir::heads, schema::archive::input)),
-    input_body_(body(config.path, schema::archive::input), config.input_size, config.input_rate),
+    input_body_(body(config.path, schema::archive::input), config.input_size, config.input_rate,
+        config.preallocate, config.preallocate_ahead),
     input(input_head_, input_body_, config.input_buckets),
 
     output_head_(head(config.path / schema::dir::heads, schema::archive::output)),
-    output_body_(body(config.path, schema::archive::output), config.output_size, config.output_rate),
-    output(output_head_, output_body_),
+    output_body_(body(config.path, schema::archive::output), config.output_size, config.output_rate,
+        config.preallocate, config.preallocate_ahead),
+    output(output_head_, output_body_, config.compact_amounts),
+
+    witness_head_(head(config.path / schema::dir::heads, schema::archive::witness)),
+    witness_body_(body(config.path, schema::archive::witness), config.witness_size, config.witness_rate,
+        config.preallocate, config.preallocate_ahead),
+    witness(witness_head_, witness_body_, config.separate_witness),
 
     puts_head_(head(config.path / schema::dir::heads, schema::archive::puts)),
-    puts_body_(body(config.path, schema::archive::puts), config.puts_size, config.puts_rate),
+    puts_body_(body(config.path, schema::archive::puts), config.puts_size, config.puts_rate,
+        config.preallocate, config.preallocate_ahead),
     puts(puts_head_, puts_body_),
 
     tx_head_(head(config.path / schema::dir::heads, schema::archive::tx)),
-    tx_body_(body(config.path, schema::archive::tx), config.tx_size, config.tx_rate),
+    tx_body_(body(config.path, schema::archive::tx), config.tx_size, config.tx_rate,
+        config.preallocate, config.preallocate_ahead),
     tx(tx_head_, tx_body_, config.tx_buckets),
 
     txs_head_(head(config.path / schema::dir::heads, schema::archive::txs)),
-    txs_body_(body(config.path, schema::archive::txs), config.txs_size, config.txs_rate),
-    txs(txs_head_, txs_body_, config.txs_buckets),
+    txs_body_(body(config.path, schema::archive::txs), config.txs_size, config.txs_rate,
+        config.preallocate, config.preallocate_ahead),
+    txs(txs_head_, txs_body_, config.txs_buckets, config.compact_txs),
 
     // Indexes.
 
     address_head_(head(config.path / schema::dir::heads, schema::indexes::address)),
-    address_body_(body(config.path, schema::indexes::address), config.address_size, config.address_rate),
+    address_body_(body(config.path, schema::indexes::address), config.address_size, config.address_rate,
+        config.preallocate, config.preallocate_ahead),
     address(address_head_, address_body_, config.address_buckets),
 
     candidate_head_(head(config.path / schema::dir::heads, schema::indexes::candidate)),
-    candidate_body_(body(config.path, schema::indexes::candidate), config.candidate_size, config.candidate_rate),
+    candidate_body_(body(config.path, schema::indexes::candidate), config.candidate_size, config.candidate_rate,
+        config.preallocate, config.preallocate_ahead),
     candidate(candidate_head_, candidate_body_),
 
     confirmed_head_(head(config.path / schema::dir::heads, schema::indexes::confirmed)),
-    confirmed_body_(body(config.path, schema::indexes::confirmed), config.confirmed_size, config.confirmed_rate),
+    confirmed_body_(body(config.path, schema::indexes::confirmed), config.confirmed_size, config.confirmed_rate,
+        config.preallocate, config.preallocate_ahead),
     confirmed(confirmed_head_, confirmed_body_),
 
+    indexed_head_(head(config.path / schema::dir::heads, schema::indexes::indexed)),
+    indexed_body_(body(config.path, schema::indexes::indexed), config.indexed_size, config.indexed_rate,
+        config.preallocate, config.preallocate_ahead),
+    indexed(indexed_head_, indexed_body_),
+
     strong_tx_head_(head(config.path / schema::dir::heads, schema::indexes::strong_tx)),
-    strong_tx_body_(body(config.path, schema::indexes::strong_tx), config.strong_tx_size, config.strong_tx_rate),
+    strong_tx_body_(body(config.path, schema::indexes::strong_tx), config.strong_tx_size, config.strong_tx_rate,
+        config.preallocate, config.preallocate_ahead),
     strong_tx(strong_tx_head_, strong_tx_body_, config.strong_tx_buckets),
 
     // Caches.
 
     bootstrap_head_(head(config.path / schema::dir::heads, schema::caches::bootstrap)),
-    bootstrap_body_(body(config.path, schema::caches::bootstrap), config.bootstrap_size, config.bootstrap_rate),
+    bootstrap_body_(body(config.path, schema::caches::bootstrap), config.bootstrap_size, config.bootstrap_rate,
+        config.preallocate, config.preallocate_ahead),
     bootstrap(bootstrap_head_, bootstrap_body_),
 
     buffer_head_(head(config.path / schema::dir::heads, schema::caches::buffer)),
-    buffer_body_(body(config.path, schema::caches::buffer), config.buffer_size, config.buffer_rate),
+    buffer_body_(body(config.path, schema::caches::buffer), config.buffer_size, config.buffer_rate,
+        config.preallocate, config.preallocate_ahead),
     buffer(buffer_head_, buffer_body_, config.buffer_buckets),
 
     neutrino_head_(head(config.path / schema::dir::heads, schema::caches::neutrino)),
-    neutrino_body_(body(config.path, schema::caches::neutrino), config.neutrino_size, config.neutrino_rate),
+    neutrino_body_(body(config.path, schema::caches::neutrino), config.neutrino_size, config.neutrino_rate,
+        config.preallocate, config.preallocate_ahead),
     neutrino(neutrino_head_, neutrino_body_, config.neutrino_buckets),
 
     validated_bk_head_(head(config.path / schema::dir::heads, schema::caches::validated_bk)),
-    validated_bk_body_(body(config.path, schema::caches::validated_bk), config.validated_bk_size, config.validated_bk_rate),
+    validated_bk_body_(body(config.path, schema::caches::validated_bk), config.validated_bk_size, config.validated_bk_rate,
+        config.preallocate, config.preallocate_ahead),
     validated_bk(validated_bk_head_, validated_bk_body_, config.validated_bk_buckets),
 
     validated_tx_head_(head(config.path / schema::dir::heads, schema::caches::validated_tx)),
-    validated_tx_body_(body(config.path, schema::caches::validated_tx), config.validated_tx_size, config.validated_tx_rate),
+    validated_tx_body_(body(config.path, schema::caches::validated_tx), config.validated_tx_size, config.validated_tx_rate,
+        config.preallocate, config.preallocate_ahead),
     validated_tx(validated_tx_head_, validated_tx_body_, config.validated_tx_buckets),
 
+    balance_head_(head(config.path / schema::dir::heads, schema::caches::balance)),
+    balance_body_(body(config.path, schema::caches::balance), config.balance_size, config.balance_rate,
+        config.preallocate, config.preallocate_ahead),
+    balance(balance_head_, balance_body_, config.balance_buckets),
+
     // Locks.
     flush_lock_(lock(config.path, schema::locks::flush)),
     process_lock_(lock(config.path, schema::locks::process))
@@ -140,6 +174,7 @@ code CLASS::create() NOEXCEPT
 
     // Clear /heads, create head files, ensure existence of body files.
     if (!file::clear_directory(heads)) ec = error::clear_directory;
+    else if (!write_version()) ec = error::create_file;
 
     else if (!file::create_file(header_head_.file())) ec = error::create_file;
     else if (!file::create_file(header_body_.file())) ec = error::create_file;
@@ -149,6 +184,8 @@ code CLASS::create() NOEXCEPT
     else if (!file::create_file(input_body_.file())) ec = error::create_file;
     else if (!file::create_file(output_head_.file())) ec = error::create_file;
     else if (!file::create_file(output_body_.file())) ec = error::create_file;
+    else if (witness.enabled() && !file::create_file(witness_head_.file())) ec = error::create_file;
+    else if (witness.enabled() && !file::create_file(witness_body_.file())) ec = error::create_file;
     else if (!file::create_file(puts_head_.file())) ec = error::create_file;
     else if (!file::create_file(puts_body_.file())) ec = error::create_file;
     else if (!file::create_file(tx_head_.file())) ec = error::create_file;
@@ -162,6 +199,8 @@ code CLASS::create() NOEXCEPT
     else if (!file::create_file(candidate_body_.file())) ec = error::create_file;
     else if (!file::create_file(confirmed_head_.file())) ec = error::create_file;
     else if (!file::create_file(confirmed_body_.file())) ec = error::create_file;
+    else if (!file::create_file(indexed_head_.file())) ec = error::create_file;
+    else if (!file::create_file(indexed_body_.file())) ec = error::create_file;
     else if (!file::create_file(strong_tx_head_.file())) ec = error::create_file;
     else if (!file::create_file(strong_tx_body_.file())) ec = error::create_file;
 
@@ -175,6 +214,8 @@ code CLASS::create() NOEXCEPT
     else if (!file::create_file(validated_bk_body_.file())) ec = error::create_file;
     else if (!file::create_file(validated_tx_head_.file())) ec = error::create_file;
     else if (!file::create_file(validated_tx_body_.file())) ec = error::create_file;
+    else if (!file::create_file(balance_head_.file())) ec = error::create_file;
+    else if (!file::create_file(balance_body_.file())) ec = error::create_file;
 
     if (!ec) ec = open_load();
 
@@ -185,6 +226,7 @@ code CLASS::create() NOEXCEPT
         else if (!point.create()) ec = error::create_table;
         else if (!input.create()) ec = error::create_table;
         else if (!output.create()) ec = error::create_table;
+        else if (witness.enabled() && !witness.create()) ec = error::create_table;
         else if (!puts.create()) ec = error::create_table;
         else if (!tx.create()) ec = error::create_table;
         else if (!txs.create()) ec = error::create_table;
@@ -192,6 +234,7 @@ code CLASS::create() NOEXCEPT
         else if (!address.create()) ec = error::create_table;
         else if (!candidate.create()) ec = error::create_table;
         else if (!confirmed.create()) ec = error::create_table;
+        else if (!indexed.create()) ec = error::create_table;
         else if (!strong_tx.create()) ec = error::create_table;
 
         else if (!bootstrap.create()) ec = error::create_table;
@@ -199,6 +242,7 @@ code CLASS::create() NOEXCEPT
         else if (!neutrino.create()) ec = error::create_table;
         else if (!validated_bk.create()) ec = error::create_table;
         else if (!validated_tx.create()) ec = error::create_table;
+        else if (!balance.create()) ec = error::create_table;
     }
 
     if (!ec) ec = unload_close();
@@ -207,6 +251,7 @@ code CLASS::create() NOEXCEPT
     if (!flush_lock_.try_unlock()) ec = error::flush_unlock;
     if (!process_lock_.try_unlock()) ec = error::process_unlock;
     if (ec) /* bool */ file::clear_directory(configuration_.path);
+    else ++generation_;
     transactor_mutex_.unlock();
     return ec;
 }
@@ -230,7 +275,13 @@ code CLASS::open() NOEXCEPT
         return error::flush_lock;
     }
 
-    auto ec = open_load();
+    code ec{ error::success };
+
+    // A store without a matching version fails before any table is opened.
+    if (file::is_file(header_head_.file()) && !read_version())
+        ec = error::store_version;
+
+    if (!ec) ec = open_load();
 
     if (!ec)
     {
@@ -238,6 +289,7 @@ code CLASS::open() NOEXCEPT
         else if (!point.verify()) ec = error::verify_table;
         else if (!input.verify()) ec = error::verify_table;
         else if (!output.verify()) ec = error::verify_table;
+        else if (witness.enabled() && !witness.verify()) ec = error::verify_table;
         else if (!puts.verify()) ec = error::verify_table;
         else if (!tx.verify()) ec = error::verify_table;
         else if (!txs.verify()) ec = error::verify_table;
@@ -245,6 +297,7 @@ code CLASS::open() NOEXCEPT
         else if (!address.verify()) ec = error::verify_table;
         else if (!candidate.verify()) ec = error::verify_table;
         else if (!confirmed.verify()) ec = error::verify_table;
+        else if (!indexed.verify()) ec = error::verify_table;
         else if (!strong_tx.verify()) ec = error::verify_table;
 
         else if (!bootstrap.verify()) ec = error::verify_table;
@@ -252,6 +305,7 @@ code CLASS::open() NOEXCEPT
         else if (!neutrino.verify()) ec = error::verify_table;
         else if (!validated_bk.verify()) ec = error::verify_table;
         else if (!validated_tx.verify()) ec = error::verify_table;
+        else if (!balance.verify()) ec = error::verify_table;
     }
 
     // This prevents close from having to follow open fail.
@@ -265,6 +319,11 @@ code CLASS::open() NOEXCEPT
         if (!process_lock_.try_unlock()) ec = error::process_unlock;
     }
 
+    else
+    {
+        ++generation_;
+    }
+
     // process and flush locks remain open until close().
     transactor_mutex_.unlock();
     return ec;
@@ -278,30 +337,37 @@ code CLASS::snapshot() NOEXCEPT
         // TODO: log deadlock_hint
     }
 
-    code ec{ error::success };
-
     // Assumes/requires tables open/loaded.
-    if (!ec) ec = header_body_.flush();
-    if (!ec) ec = point_body_.flush();
-    if (!ec) ec = input_body_.flush();
-    if (!ec) ec = output_body_.flush();
-    if (!ec) ec = puts_body_.flush();
-    if (!ec) ec = tx_body_.flush();
-    if (!ec) ec = txs_body_.flush();
-
-    if (!ec) ec = address_body_.flush();
-    if (!ec) ec = candidate_body_.flush();
-    if (!ec) ec = confirmed_body_.flush();
-    if (!ec) ec = strong_tx_body_.flush();
+    auto ec = flush_bodies();
+    if (!ec) ec = backup();
+    transactor_mutex_.unlock();
+    return ec;
+}
 
-    if (!ec) ec = bootstrap_body_.flush();
-    if (!ec) ec = buffer_body_.flush();
-    if (!ec) ec = neutrino_body_.flush();
-    if (!ec) ec = validated_bk_body_.flush();
-    if (!ec) ec = validated_tx_body_.flush();
+TEMPLATE
+code CLASS::hot_snapshot() NOEXCEPT
+{
+    while (!transactor_mutex_.try_lock_for(boost::chrono::seconds(1)))
+    {
+        // TODO: log deadlock_hint
+    }
 
-    if (!ec) ec = backup();
+    // Writers are suspended while body counts and heads are captured, and
+    // while bodies that are written below their counts are flushed. Height
+    // indexes are truncated and rewritten, and address, balance and
+    // bootstrap records are updated in place. These are flushed in full (the
+    // storage flush is whole file), so writers stall for their dirty pages.
+    buffers heads{};
+    auto ec = backup_tables();
+    if (!ec) ec = copy(heads);
+    if (!ec) ec = flush_updated_bodies();
     transactor_mutex_.unlock();
+
+    // Remaining bodies are only appended, so data beyond captured counts is
+    // unreferenced by the captured heads. Flushing it with captured data is
+    // benign. Heads are not published (to /primary) until bodies are flushed.
+    if (!ec) ec = flush_appended_bodies();
+    if (!ec) ec = backup(heads);
     return ec;
 }
 
@@ -319,6 +385,7 @@ code CLASS::close() NOEXCEPT
         else if (!point.close()) ec = error::close_table;
         else if (!input.close()) ec = error::close_table;
         else if (!output.close()) ec = error::close_table;
+        else if (witness.enabled() && !witness.close()) ec = error::close_table;
         else if (!puts.close()) ec = error::close_table;
         else if (!tx.close()) ec = error::close_table;
         else if (!txs.close()) ec = error::close_table;
@@ -326,6 +393,7 @@ code CLASS::close() NOEXCEPT
         else if (!address.close()) ec = error::close_table;
         else if (!candidate.close()) ec = error::close_table;
         else if (!confirmed.close()) ec = error::close_table;
+        else if (!indexed.close()) ec = error::close_table;
         else if (!strong_tx.close()) ec = error::close_table;
 
         else if (!bootstrap.close()) ec = error::close_table;
@@ -333,6 +401,7 @@ code CLASS::close() NOEXCEPT
         else if (!neutrino.close()) ec = error::close_table;
         else if (!validated_bk.close()) ec = error::close_table;
         else if (!validated_tx.close()) ec = error::close_table;
+        else if (!balance.close()) ec = error::close_table;
     }
 
     first_code(ec, unload_close());
@@ -350,6 +419,59 @@ const typename CLASS::transactor CLASS::get_transactor() NOEXCEPT
     return transactor{ transactor_mutex_ };
 }
 
+TEMPLATE
+const typename CLASS::indexer CLASS::get_indexer() NOEXCEPT
+{
+    return indexer{ indexer_mutex_ };
+}
+
+TEMPLATE
+size_t CLASS::generation() const NOEXCEPT
+{
+    return generation_.load();
+}
+
+TEMPLATE
+bool CLASS::write_version() NOEXCEPT
+{
+    // The address id salt is random per store, fixed at create.
+    system::half_hash salt{};
+    std::random_device device{};
+    for (auto& byte: salt)
+        byte = system::narrow_cast<uint8_t>(device());
+
+    system::data_chunk data{ schema::version::value };
+    data.insert(data.end(), salt.begin(), salt.end());
+    if (!file::create_file(version(configuration_.path), data.data(),
+        data.size()))
+        return false;
+
+    address.set_salt(salt);
+    return true;
+}
+
+TEMPLATE
+bool CLASS::read_version() NOEXCEPT
+{
+    constexpr auto expected = add1(array_count<system::half_hash>);
+
+    size_t size{};
+    if (!file::size(size, version(configuration_.path)) || size != expected)
+        return false;
+
+    system::data_chunk data(expected);
+    system::ifstream file(version(configuration_.path),
+        std::ios_base::binary);
+    file.read(system::pointer_cast<char>(data.data()), expected);
+    if (!file.good() || data.front() != schema::version::value)
+        return false;
+
+    system::half_hash salt{};
+    std::copy(std::next(data.begin()), data.end(), salt.begin());
+    address.set_salt(salt);
+    return true;
+}
+
 TEMPLATE
 code CLASS::open_load() NOEXCEPT
 {
@@ -363,6 +485,8 @@ code CLASS::open_load() NOEXCEPT
     if (!ec) ec = input_body_.open();
     if (!ec) ec = output_head_.open();
     if (!ec) ec = output_body_.open();
+    if (!ec && witness.enabled()) ec = witness_head_.open();
+    if (!ec && witness.enabled()) ec = witness_body_.open();
     if (!ec) ec = puts_head_.open();
     if (!ec) ec = puts_body_.open();
     if (!ec) ec = tx_head_.open();
@@ -376,6 +500,8 @@ code CLASS::open_load() NOEXCEPT
     if (!ec) ec = candidate_body_.open();
     if (!ec) ec = confirmed_head_.open();
     if (!ec) ec = confirmed_body_.open();
+    if (!ec) ec = indexed_head_.open();
+    if (!ec) ec = indexed_body_.open();
     if (!ec) ec = strong_tx_head_.open();
     if (!ec) ec = strong_tx_body_.open();
 
@@ -389,6 +515,8 @@ code CLASS::open_load() NOEXCEPT
     if (!ec) ec = validated_bk_body_.open();
     if (!ec) ec = validated_tx_head_.open();
     if (!ec) ec = validated_tx_body_.open();
+    if (!ec) ec = balance_head_.open();
+    if (!ec) ec = balance_body_.open();
 
     if (!ec) ec = header_head_.load();
     if (!ec) ec = header_body_.load();
@@ -398,6 +526,8 @@ code CLASS::open_load() NOEXCEPT
     if (!ec) ec = input_body_.load();
     if (!ec) ec = output_head_.load();
     if (!ec) ec = output_body_.load();
+    if (!ec && witness.enabled()) ec = witness_head_.load();
+    if (!ec && witness.enabled()) ec = witness_body_.load();
     if (!ec) ec = puts_head_.load();
     if (!ec) ec = puts_body_.load();
     if (!ec) ec = tx_head_.load();
@@ -411,6 +541,8 @@ code CLASS::open_load() NOEXCEPT
     if (!ec) ec = candidate_body_.load();
     if (!ec) ec = confirmed_head_.load();
     if (!ec) ec = confirmed_body_.load();
+    if (!ec) ec = indexed_head_.load();
+    if (!ec) ec = indexed_body_.load();
     if (!ec) ec = strong_tx_head_.load();
     if (!ec) ec = strong_tx_body_.load();
 
@@ -424,6 +556,8 @@ code CLASS::open_load() NOEXCEPT
     if (!ec) ec = validated_bk_body_.load();
     if (!ec) ec = validated_tx_head_.load();
     if (!ec) ec = validated_tx_body_.load();
+    if (!ec) ec = balance_head_.load();
+    if (!ec) ec = balance_body_.load();
 
     return ec;
 }
@@ -441,6 +575,8 @@ code CLASS::unload_close() NOEXCEPT
     first_code(ec, input_body_.unload());
     first_code(ec, output_head_.unload());
     first_code(ec, output_body_.unload());
+    if (witness.enabled()) first_code(ec, witness_head_.unload());
+    if (witness.enabled()) first_code(ec, witness_body_.unload());
     first_code(ec, puts_head_.unload());
     first_code(ec, puts_body_.unload());
     first_code(ec, tx_head_.unload());
@@ -454,6 +590,8 @@ code CLASS::unload_close() NOEXCEPT
     first_code(ec, candidate_body_.unload());
     first_code(ec, confirmed_head_.unload());
     first_code(ec, confirmed_body_.unload());
+    first_code(ec, indexed_head_.unload());
+    first_code(ec, indexed_body_.unload());
     first_code(ec, strong_tx_head_.unload());
     first_code(ec, strong_tx_body_.unload());
 
@@ -467,6 +605,8 @@ code CLASS::unload_close() NOEXCEPT
     first_code(ec, validated_bk_body_.unload());
     first_code(ec, validated_tx_head_.unload());
     first_code(ec, validated_tx_body_.unload());
+    first_code(ec, balance_head_.unload());
+    first_code(ec, balance_body_.unload());
 
     first_code(ec, header_head_.close());
     first_code(ec, header_body_.close());
@@ -476,6 +616,8 @@ code CLASS::unload_close() NOEXCEPT
     first_code(ec, input_body_.close());
     first_code(ec, output_head_.close());
     first_code(ec, output_body_.close());
+    if (witness.enabled()) first_code(ec, witness_head_.close());
+    if (witness.enabled()) first_code(ec, witness_body_.close());
     first_code(ec, puts_head_.close());
     first_code(ec, puts_body_.close());
     first_code(ec, tx_head_.close());
@@ -489,6 +631,8 @@ code CLASS::unload_close() NOEXCEPT
     first_code(ec, candidate_body_.close());
     first_code(ec, confirmed_head_.close());
     first_code(ec, confirmed_body_.close());
+    first_code(ec, indexed_head_.close());
+    first_code(ec, indexed_body_.close());
     first_code(ec, strong_tx_head_.close());
     first_code(ec, strong_tx_body_.close());
 
@@ -502,17 +646,72 @@ code CLASS::unload_close() NOEXCEPT
     first_code(ec, validated_bk_body_.close());
     first_code(ec, validated_tx_head_.close());
     first_code(ec, validated_tx_body_.close());
+    first_code(ec, balance_head_.close());
+    first_code(ec, balance_body_.close());
 
     return ec;
 }
 
+// Assumes/requires tables open/loaded.
 TEMPLATE
-code CLASS::backup() NOEXCEPT
+code CLASS::flush_bodies() NOEXCEPT
+{
+    auto ec = flush_updated_bodies();
+    if (!ec) ec = flush_appended_bodies();
+    return ec;
+}
+
+// Bodies written below their logical size (in place or after truncation).
+TEMPLATE
+code CLASS::flush_updated_bodies() NOEXCEPT
+{
+    code ec{ error::success };
+
+    if (!ec) ec = address_body_.flush();
+    if (!ec) ec = candidate_body_.flush();
+    if (!ec) ec = confirmed_body_.flush();
+    if (!ec) ec = indexed_body_.flush();
+
+    if (!ec) ec = bootstrap_body_.flush();
+    if (!ec) ec = balance_body_.flush();
+
+    return ec;
+}
+
+// Bodies written only above their logical size.
+TEMPLATE
+code CLASS::flush_appended_bodies() NOEXCEPT
+{
+    code ec{ error::success };
+
+    if (!ec) ec = header_body_.flush();
+    if (!ec) ec = point_body_.flush();
+    if (!ec) ec = input_body_.flush();
+    if (!ec) ec = output_body_.flush();
+    if (!ec && witness.enabled()) ec = witness_body_.flush();
+    if (!ec) ec = puts_body_.flush();
+    if (!ec) ec = tx_body_.flush();
+    if (!ec) ec = txs_body_.flush();
+
+    if (!ec) ec = strong_tx_body_.flush();
+
+    if (!ec) ec = buffer_body_.flush();
+    if (!ec) ec = neutrino_body_.flush();
+    if (!ec) ec = validated_bk_body_.flush();
+    if (!ec) ec = validated_tx_body_.flush();
+
+    return ec;
+}
+
+// Write body counts to heads.
+TEMPLATE
+code CLASS::backup_tables() NOEXCEPT
 {
     if (!header.backup()) return error::backup_table;
     if (!point.backup()) return error::backup_table;
     if (!input.backup()) return error::backup_table;
     if (!output.backup()) return error::backup_table;
+    if (witness.enabled() && !witness.backup()) return error::backup_table;
     if (!puts.backup()) return error::backup_table;
     if (!tx.backup()) return error::backup_table;
     if (!txs.backup()) return error::backup_table;
@@ -520,6 +719,7 @@ code CLASS::backup() NOEXCEPT
     if (!address.backup()) return error::backup_table;
     if (!candidate.backup()) return error::backup_table;
     if (!confirmed.backup()) return error::backup_table;
+    if (!indexed.backup()) return error::backup_table;
     if (!strong_tx.backup()) return error::backup_table;
 
     if (!bootstrap.backup()) return error::backup_table;
@@ -527,23 +727,154 @@ code CLASS::backup() NOEXCEPT
     if (!neutrino.backup()) return error::backup_table;
     if (!validated_bk.backup()) return error::backup_table;
     if (!validated_tx.backup()) return error::backup_table;
+    if (!balance.backup()) return error::backup_table;
+
+    return error::success;
+}
+
+TEMPLATE
+code CLASS::backup() NOEXCEPT
+{
+    auto ec = backup_tables();
+    if (!ec) ec = rotate();
+    if (ec) return ec;
+
+    static const auto primary = configuration_.path / schema::dir::primary;
+
+    // Dump /heads memory maps to /primary.
+    if (!file::clear_directory(primary)) return error::create_directory;
+    ec = dump(primary);
+    if (ec) /* bool */ file::clear_directory(primary);
+    return ec;
+}
+
+TEMPLATE
+code CLASS::backup(const buffers& heads) NOEXCEPT
+{
+    auto ec = rotate();
+    if (ec) return ec;
 
+    static const auto primary = configuration_.path / schema::dir::primary;
+
+    // Dump captured heads to /primary.
+    if (!file::clear_directory(primary)) return error::create_directory;
+    ec = dump(primary, heads);
+    if (ec) /* bool */ file::clear_directory(primary);
+    return ec;
+}
+
+// Delete /secondary, rename /primary to /secondary.
+TEMPLATE
+code CLASS::rotate() NOEXCEPT
+{
     static const auto primary = configuration_.path / schema::dir::primary;
     static const auto secondary = configuration_.path / schema::dir::secondary;
 
     if (file::is_directory(primary))
     {
-        // Delete /secondary, rename /primary to /secondary.
         if (!file::clear_directory(secondary)) return error::clear_directory;
         if (!file::remove(secondary)) return error::remove_directory;
         if (!file::rename(primary, secondary)) return error::rename_directory;
     }
 
-    // Dump /heads memory maps to /primary.
-    if (!file::clear_directory(primary)) return error::create_directory;
-    const auto ec = dump(primary);
-    if (ec) /* bool */ file::clear_directory(primary);
-    return ec;
+    return error::success;
+}
+
+// Copy memory maps of /heads to buffers (in dump order).
+TEMPLATE
+code CLASS::copy(buffers& heads) NOEXCEPT
+{
+    const std_array<const Storage*, 19> files
+    {
+        &header_head_,
+        &point_head_,
+        &input_head_,
+        &output_head_,
+        &witness_head_,
+        &puts_head_,
+        &tx_head_,
+        &txs_head_,
+
+        &address_head_,
+        &candidate_head_,
+        &confirmed_head_,
+        &indexed_head_,
+        &strong_tx_head_,
+
+        &bootstrap_head_,
+        &buffer_head_,
+        &neutrino_head_,
+        &validated_bk_head_,
+        &validated_tx_head_,
+        &balance_head_
+    };
+
+    heads.clear();
+    heads.reserve(files.size());
+    for (const auto item: files)
+    {
+        // The witness head is not opened when the table is disabled.
+        if (item == &witness_head_ && !witness.enabled())
+            continue;
+
+        const auto buffer = item->get();
+        if (!buffer)
+            return error::unloaded_file;
+
+        heads.emplace_back(buffer->begin(), buffer->end());
+    }
+
+    return error::success;
+}
+
+// Write buffers of copy() to new files in folder.
+TEMPLATE
+code CLASS::dump(const path& folder, const buffers& heads) NOEXCEPT
+{
+    static const std_array<std::string, 19> names
+    {
+        schema::archive::header,
+        schema::archive::point,
+        schema::archive::input,
+        schema::archive::output,
+        schema::archive::witness,
+        schema::archive::puts,
+        schema::archive::tx,
+        schema::archive::txs,
+
+        schema::indexes::address,
+        schema::indexes::candidate,
+        schema::indexes::confirmed,
+        schema::indexes::indexed,
+        schema::indexes::strong_tx,
+
+        schema::caches::bootstrap,
+        schema::caches::buffer,
+        schema::caches::neutrino,
+        schema::caches::validated_bk,
+        schema::caches::validated_tx,
+        schema::caches::balance
+    };
+
+    // Buffers are in names order, without witness when it is disabled.
+    const auto skip = witness.enabled() ? zero : one;
+    if (heads.size() != names.size() - skip)
+        return error::unloaded_file;
+
+    auto buffer = heads.begin();
+    for (const auto& name: names)
+    {
+        if (!witness.enabled() && name == schema::archive::witness)
+            continue;
+
+        if (!file::create_file(head(folder, name), buffer->data(),
+            buffer->size()))
+            return error::dump_file;
+
+        ++buffer;
+    }
+
+    return error::success;
 }
 
 // Dump memory maps of /heads to new files in /primary.
@@ -554,6 +885,7 @@ code CLASS::dump(const path& folder) NOEXCEPT
     auto point_buffer = point_head_.get();
     auto input_buffer = input_head_.get();
     auto output_buffer = output_head_.get();
+    auto witness_buffer = witness_head_.get();
     auto puts_buffer = puts_head_.get();
     auto tx_buffer = tx_head_.get();
     auto txs_buffer = txs_head_.get();
@@ -561,6 +893,7 @@ code CLASS::dump(const path& folder) NOEXCEPT
     auto address_buffer = address_head_.get();
     auto candidate_buffer = candidate_head_.get();
     auto confirmed_buffer = confirmed_head_.get();
+    auto indexed_buffer = indexed_head_.get();
     auto strong_tx_buffer = strong_tx_head_.get();
 
     auto bootstrap_buffer = bootstrap_head_.get();
@@ -568,11 +901,13 @@ code CLASS::dump(const path& folder) NOEXCEPT
     auto neutrino_buffer = neutrino_head_.get();
     auto validated_bk_buffer = validated_bk_head_.get();
     auto validated_tx_buffer = validated_tx_head_.get();
+    auto balance_buffer = balance_head_.get();
 
     if (!header_buffer) return error::unloaded_file;
     if (!point_buffer) return error::unloaded_file;
     if (!input_buffer) return error::unloaded_file;
     if (!output_buffer) return error::unloaded_file;
+    if (witness.enabled() && !witness_buffer) return error::unloaded_file;
     if (!puts_buffer) return error::unloaded_file;
     if (!tx_buffer) return error::unloaded_file;
     if (!txs_buffer) return error::unloaded_file;
@@ -580,6 +915,7 @@ code CLASS::dump(const path& folder) NOEXCEPT
     if (!address_buffer) return error::unloaded_file;
     if (!candidate_buffer) return error::unloaded_file;
     if (!confirmed_buffer) return error::unloaded_file;
+    if (!indexed_buffer) return error::unloaded_file;
     if (!strong_tx_buffer) return error::unloaded_file;
 
     if (!bootstrap_buffer) return error::unloaded_file;
@@ -587,6 +923,7 @@ code CLASS::dump(const path& folder) NOEXCEPT
     if (!neutrino_buffer) return error::unloaded_file;
     if (!validated_bk_buffer) return error::unloaded_file;
     if (!validated_tx_buffer) return error::unloaded_file;
+    if (!balance_buffer) return error::unloaded_file;
 
     if (!file::create_file(head(folder, schema::archive::header),
         header_buffer->begin(), header_buffer->size()))
@@ -604,6 +941,11 @@ code CLASS::dump(const path& folder) NOEXCEPT
         output_buffer->begin(), output_buffer->size()))
         return error::dump_file;
 
+    if (witness.enabled() && !file::create_file(head(folder,
+        schema::archive::witness), witness_buffer->begin(),
+        witness_buffer->size()))
+        return error::dump_file;
+
     if (!file::create_file(head(folder, schema::archive::puts),
         puts_buffer->begin(), puts_buffer->size()))
         return error::dump_file;
@@ -629,6 +971,10 @@ code CLASS::dump(const path& folder) NOEXCEPT
         confirmed_buffer->begin(), confirmed_buffer->size()))
         return error::dump_file;
 
+    if (!file::create_file(head(folder, schema::indexes::indexed),
+        indexed_buffer->begin(), indexed_buffer->size()))
+        return error::dump_file;
+
     if (!file::create_file(head(folder, schema::indexes::strong_tx),
         strong_tx_buffer->begin(), strong_tx_buffer->size()))
         return error::dump_file;
@@ -654,6 +1000,10 @@ code CLASS::dump(const path& folder) NOEXCEPT
         validated_tx_buffer->begin(), validated_tx_buffer->size()))
         return error::dump_file;
 
+    if (!file::create_file(head(folder, schema::caches::balance),
+        balance_buffer->begin(), balance_buffer->size()))
+        return error::dump_file;
+
     return error::success;
 }
 
@@ -708,6 +1058,7 @@ code CLASS::restore() NOEXCEPT
         else if (!point.restore()) ec = error::restore_table;
         else if (!input.restore()) ec = error::restore_table;
         else if (!output.restore()) ec = error::restore_table;
+        else if (witness.enabled() && !witness.restore()) ec = error::restore_table;
         else if (!puts.restore()) ec = error::restore_table;
         else if (!tx.restore()) ec = error::restore_table;
         else if (!txs.restore()) ec = error::restore_table;
@@ -715,6 +1066,7 @@ code CLASS::restore() NOEXCEPT
         else if (!address.restore()) ec = error::restore_table;
         else if (!candidate.restore()) ec = error::restore_table;
         else if (!confirmed.restore()) ec = error::restore_table;
+        else if (!indexed.restore()) ec = error::restore_table;
         else if (!strong_tx.restore()) ec = error::restore_table;
 
         else if (!bootstrap.restore()) ec = error::restore_table;
@@ -722,6 +1074,7 @@ code CLASS::restore() NOEXCEPT
         else if (!neutrino.restore()) ec = error::restore_table;
         else if (!validated_bk.restore()) ec = error::restore_table;
         else if (!validated_tx.restore()) ec = error::restore_table;
+        else if (!balance.restore()) ec = error::restore_table;
 
         else if (!ec) ec = unload_close();
     }
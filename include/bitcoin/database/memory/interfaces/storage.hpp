@@ -66,6 +66,12 @@ public:
 
     /// Get r/w access to start/offset of memory map (or null).
     virtual memory_ptr get(size_t offset=zero) const NOEXCEPT = 0;
+
+    /// Hint that [offset, offset + size) will soon be read (advisory).
+    virtual void prefetch(size_t offset, size_t size) const NOEXCEPT = 0;
+
+    /// Keep allocation offsets multiples of unit (record size), must be closed.
+    virtual void align(size_t unit) NOEXCEPT = 0;
 };
 
 } // namespace database
@@ -20,6 +20,7 @@
 #define LIBBITCOIN_DATABASE_MEMORY_MAP_HPP
 
 #include <filesystem>
+#include <future>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/boost.hpp>
 #include <bitcoin/database/define.hpp>
@@ -37,8 +38,11 @@ class BCD_API map
 public:
     DELETE_COPY_MOVE(map);
 
+    /// Growth is sparse (ftruncate) unless preallocate, in which case blocks
+    /// are allocated on growth. If also ahead, the next expansion step beyond
+    /// capacity is reserved in the background following each growth.
     map(const std::filesystem::path& filename, size_t minimum=1,
-        size_t expansion=0) NOEXCEPT;
+        size_t expansion=0, bool preallocate=false, bool ahead=false) NOEXCEPT;
 
     /// Destruct for debug assertion only.
     virtual ~map() NOEXCEPT;
@@ -85,6 +89,12 @@ public:
     /// Get r/w access to start/offset of memory map (or null).
     memory_ptr get(size_t offset=zero) const NOEXCEPT override;
 
+    /// Initiate asynchronous read of pages in range (no effect if unloaded).
+    void prefetch(size_t offset, size_t size) const NOEXCEPT override;
+
+    /// Allocations are contiguous, so offsets are always aligned (no-op).
+    void align(size_t unit) NOEXCEPT override;
+
 protected:
     size_t to_capacity(size_t required) const NOEXCEPT
     {
@@ -107,11 +117,16 @@ private:
     bool map_() NOEXCEPT;
     bool remap_(size_t size) NOEXCEPT;
     bool finalize_(size_t size) NOEXCEPT;
+    bool resize_(size_t size) NOEXCEPT;
+    void reserve_() NOEXCEPT;
+    bool reserved_() NOEXCEPT;
 
     // Constants.
     const std::filesystem::path filename_;
     const size_t minimum_;
     const size_t expansion_;
+    const bool preallocate_;
+    const bool ahead_;
 
     // Protected by mutex.
     uint8_t* memory_map_;
@@ -123,6 +138,9 @@ private:
     size_t capacity_;
     int descriptor_;
     mutable mutex field_mutex_;
+
+    // Protected by exclusive map_mutex_.
+    std::future<bool> reservation_;
 };
 
 } // namespace database
@@ -25,6 +25,7 @@
 #include <bitcoin/database/memory/interfaces/storage.hpp>
 #include <bitcoin/database/memory/map.hpp>
 #include <bitcoin/database/memory/reader.hpp>
+#include <bitcoin/database/memory/segments.hpp>
 #include <bitcoin/database/memory/writer.hpp>
 
 #endif
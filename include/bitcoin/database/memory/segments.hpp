@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_MEMORY_SEGMENTS_HPP
+#define LIBBITCOIN_DATABASE_MEMORY_SEGMENTS_HPP
+
+#include <filesystem>
+#include <memory>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/boost.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/error.hpp>
+#include <bitcoin/database/memory/interfaces/memory.hpp>
+#include <bitcoin/database/memory/interfaces/storage.hpp>
+#include <bitcoin/database/memory/map.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Thread safe access to a sequence of fixed-size memory-mapped files.
+/// The first segment is the named file, others are suffixed ".1", ".2"...
+/// Growth adds a segment without remapping others, and segment files may be
+/// symlinked to other volumes. An allocation that does not fit in the last
+/// segment pads that segment to full. Record links are offsets divided by
+/// record size, so align() rounds the segment size to a record multiple. A
+/// multiple record allocation may still leave unreferenced padding records.
+class BCD_API segments
+  : public storage
+{
+public:
+    DELETE_COPY_MOVE(segments);
+
+    /// Default size of each segment file (1GiB).
+    static constexpr size_t default_segment = 1024u * 1024u * 1024u;
+
+    segments(const std::filesystem::path& filename, size_t minimum=1,
+        size_t expansion=0, bool preallocate=false, bool ahead=false,
+        size_t segment=default_segment) NOEXCEPT;
+
+    /// Destruct for debug assertion only.
+    virtual ~segments() NOEXCEPT;
+
+    /// The size of each segment file (as aligned).
+    size_t segment() const NOEXCEPT;
+
+    /// The number of segments spanned by the logical size (zero if closed).
+    size_t count() const NOEXCEPT;
+
+    /// storage interface
+    /// -----------------------------------------------------------------------
+
+    /// Open all segment files, must be closed.
+    code open() NOEXCEPT override;
+
+    /// Close all segment files, must be unloaded, idempotent.
+    code close() NOEXCEPT override;
+
+    /// Map all segment files to memory, must be loaded.
+    code load() NOEXCEPT override;
+
+    /// Flush all memory maps to disk, suspend writes for call, must be loaded.
+    code flush() const NOEXCEPT override;
+
+    /// Flush, unmap and truncate all segments, restartable, idempotent.
+    code unload() NOEXCEPT override;
+
+    /// The filesystem path of the first segment.
+    const std::filesystem::path& file() const NOEXCEPT override;
+
+    /// The current capacity of the memory maps (zero if unloaded).
+    size_t capacity() const NOEXCEPT override;
+
+    /// The current logical size of the memory maps (zero if closed).
+    size_t size() const NOEXCEPT override;
+
+    /// Reduce logical size to specified (false if size exceeds logical).
+    bool truncate(size_t size) NOEXCEPT override;
+
+    /// Allocate bytes and return offset to first allocated (or eof).
+    /// Chunk cannot exceed segment size, as it cannot span segments.
+    size_t allocate(size_t chunk) NOEXCEPT override;
+
+    /// Get r/w access to offset, bounded by the end of its segment (or null).
+    /// Offset zero returns access to all segments (offset() spans segments).
+    memory_ptr get(size_t offset=zero) const NOEXCEPT override;
+
+    /// Initiate asynchronous read of pages in range (no effect if unloaded).
+    void prefetch(size_t offset, size_t size) const NOEXCEPT override;
+
+    /// Round the segment size down to a multiple of unit (at least unit).
+    void align(size_t unit) NOEXCEPT override;
+
+protected:
+    std::filesystem::path to_file(size_t index) const NOEXCEPT;
+
+private:
+    using mutex = boost::upgrade_mutex;
+    using maps = std_vector<std::unique_ptr<map>>;
+
+    // Utilities, not thread safe.
+    size_t size_() const NOEXCEPT;
+    bool add_() NOEXCEPT;
+
+    // Constants.
+    const std::filesystem::path filename_;
+    const size_t minimum_;
+    const size_t expansion_;
+    const bool preallocate_;
+    const bool ahead_;
+
+    // Set by align() before open.
+    size_t segment_;
+
+    // Protected by mutex (map objects are individually thread safe).
+    maps maps_;
+    size_t active_;
+    bool loaded_;
+    mutable mutex mutex_;
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
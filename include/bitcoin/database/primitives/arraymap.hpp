@@ -57,10 +57,24 @@ public:
     Link count() const NOEXCEPT;
     bool truncate(const Link& count) NOEXCEPT;
 
+    /// Get memory at element, holds shared lock on storage remap.
+    /// Pointer must be released prior to any write that may remap storage.
+    memory_ptr get_memory(const Link& link) const NOEXCEPT;
+
+    /// Hint that element at link will soon be read (advisory).
+    void prefetch(const Link& link) const NOEXCEPT;
+
+    /// Allocate count or slab size at returned link (follow with set).
+    Link allocate(const Link& size) NOEXCEPT;
+
     /// Get element at link.
     template <typename Element, if_equal<Element::size, Size> = true>
     bool get(const Link& link, Element& element) const NOEXCEPT;
 
+    /// Set element into previously allocated link.
+    template <typename Element, if_equal<Element::size, Size> = true>
+    bool set(const Link& link, const Element& element) NOEXCEPT;
+
     /// Put element.
     template <typename Element, if_equal<Element::size, Size> = true>
     bool put(const Element& element) NOEXCEPT;
@@ -74,6 +88,7 @@ public:
 protected:
     reader_ptr getter(const Link& link) const NOEXCEPT;
     writer_ptr creater(Link& link, const Link& size) NOEXCEPT;
+    writer_ptr setter(const Link& link, const Link& size) NOEXCEPT;
 
 private:
     static constexpr auto is_slab = (Size == max_size_t);
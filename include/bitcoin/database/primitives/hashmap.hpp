@@ -59,6 +59,9 @@ public:
     /// Query interface, iterator is not thread safe.
     /// -----------------------------------------------------------------------
 
+    /// Count of records or slab bytes (allocated, including uncommitted).
+    Link count() const NOEXCEPT;
+
     /// True if an instance of object with key exists.
     bool exists(const Key& key) const NOEXCEPT;
 
@@ -68,12 +71,23 @@ public:
     /// Iterator holds shared lock on storage remap.
     iterator it(const Key& key) const NOEXCEPT;
 
+    /// Iterator resumed from start, which must be an element of the key's
+    /// chain (such as a prior iterator's self), advancing to match if not.
+    iterator it(const Key& key, const Link& start) const NOEXCEPT;
+
     /// Allocate element at returned link (follow with set|put).
     Link allocate(const Link& size) NOEXCEPT;
 
     /// Return the associated search key (terminal link returns default).
     Key get_key(const Link& link) NOEXCEPT;
 
+    /// Get memory at element (from link), holds shared lock on storage remap.
+    /// Pointer must be released prior to any write that may remap storage.
+    memory_ptr get_memory(const Link& link) const NOEXCEPT;
+
+    /// Hint that element at link will soon be read (advisory).
+    void prefetch(const Link& link) const NOEXCEPT;
+
     /// Get element at link, false if deserialize error.
     template <typename Element, if_equal<Element::size, Size> = true>
     bool get(const Link& link, Element& element) const NOEXCEPT;
@@ -58,6 +58,10 @@ public:
     /// Return memory object for the full memory map.
     memory_ptr get() const NOEXCEPT;
 
+    /// Hint that record at specified position will soon be read (advisory).
+    /// For slab the size is unknown, so only the first page is prefetched.
+    void prefetch(const Link& link) const NOEXCEPT;
+
 private:
     static constexpr auto is_slab = (Size == max_size_t);
     static constexpr size_t link_to_position(const Link& link) NOEXCEPT;
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_PRIMITIVES_VIEW_HPP
+#define LIBBITCOIN_DATABASE_PRIMITIVES_VIEW_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/memory/memory.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Caution: view holds body remap lock until disposed (as with reader).
+/// Zero-copy field access to a fixed size element in the mapped body. Field
+/// offsets are compile-time and each read is a direct (unaligned) load, in
+/// place of reader construction and sequential stream decoding. Prefix is the
+/// element's link and key size (zero for array elements).
+template <size_t Prefix, size_t Size>
+class view
+{
+public:
+    DEFAULT_COPY_MOVE_DESTRUCT(view);
+
+    static constexpr auto size = Size;
+
+    /// Construct an invalid view.
+    view() NOEXCEPT;
+
+    /// Construct a view of element memory (invalid if null or truncated).
+    view(memory_ptr memory) NOEXCEPT;
+
+    /// True if the view references a complete element.
+    operator bool() const NOEXCEPT;
+
+protected:
+    /// Little-endian integer of Bytes at Offset (zero if invalid view).
+    template <size_t Offset, typename Integer, size_t Bytes = sizeof(Integer)>
+    inline Integer read_little_endian() const NOEXCEPT;
+
+    /// Byte at Offset (zero if invalid view).
+    template <size_t Offset>
+    inline uint8_t read_byte() const NOEXCEPT;
+
+    /// Hash at Offset (null hash if invalid view).
+    template <size_t Offset>
+    inline hash_digest read_hash() const NOEXCEPT;
+
+private:
+    static bool is_complete(const memory_ptr& memory) NOEXCEPT;
+
+    memory_ptr memory_;
+    const uint8_t* data_;
+};
+
+template <typename Element>
+using hash_view = view<Element::pk + Element::sk, Element::size>;
+
+template <typename Element>
+using array_view = view<zero, Element::size>;
+
+} // namespace database
+} // namespace libbitcoin
+
+#define TEMPLATE template <size_t Prefix, size_t Size>
+#define CLASS view<Prefix, Size>
+
+#include <bitcoin/database/impl/primitives/view.ipp>
+
+#undef CLASS
+#undef TEMPLATE
+
+#endif
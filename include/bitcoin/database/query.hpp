@@ -19,6 +19,13 @@
 #ifndef LIBBITCOIN_DATABASE_QUERY_HPP
 #define LIBBITCOIN_DATABASE_QUERY_HPP
 
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/primitives/primitives.hpp>
@@ -34,6 +41,7 @@ using input_link = table::input::link;
 using output_link = table::output::link;
 using tx_link = table::transaction::link;
 using height_link = table::height::link;
+using address_link = table::address::link;
 using header_link = table::header::link;
 using txs_link = table::txs::link;
 using tx_links = std_vector<tx_link::integer>;
@@ -51,6 +59,7 @@ public:
     using point = system::chain::point;
     using input = system::chain::input;
     using output = system::chain::output;
+    using script = system::chain::script;
     using header = system::chain::header;
     using transaction = system::chain::transaction;
     using inputs_ptr = system::chain::inputs_ptr;
@@ -58,6 +67,22 @@ public:
     using transactions_ptr = system::chain::transactions_ptr;
     using heights = std_vector<size_t>;
     using filter = system::data_chunk;
+    using filter_handler = std::function<bool(size_t height,
+        const hash_digest& filter_head, const system::data_slice& filter)>;
+
+    /// Header fields of a candidate or confirmed chain entry.
+    struct chain_header
+    {
+        header_link link{};
+        header_link parent{};
+        hash_digest hash{};
+        hash_digest merkle_root{};
+        context ctx{};
+        uint32_t version{};
+        uint32_t timestamp{};
+        uint32_t bits{};
+        uint32_t nonce{};
+    };
 
     query(Store& value) NOEXCEPT;
 
@@ -162,6 +187,22 @@ public:
     input::cptr get_input(const tx_link& link, uint32_t input_index) NOEXCEPT;
     inputs_ptr get_spenders(const tx_link& link, uint32_t output_index) NOEXCEPT;
 
+    /// Wire serialization read directly from tables (no chain objects).
+    bool get_transaction_data(system::data_chunk& out, const tx_link& link,
+        bool witness) NOEXCEPT;
+    bool get_block_data(system::data_chunk& out, const header_link& link,
+        bool witness) NOEXCEPT;
+
+    /// Streaming wire serialization, witness optional (stripped if false).
+    /// Sizes are obtained from stored tx sizes, for message preallocation.
+    bool get_tx_size(size_t& out, const tx_link& link, bool witness) NOEXCEPT;
+    bool get_block_size(size_t& out, const header_link& link,
+        bool witness) NOEXCEPT;
+    bool write_transaction(system::writer& sink, const tx_link& link,
+        bool witness) NOEXCEPT;
+    bool write_block(system::writer& sink, const header_link& link,
+        bool witness) NOEXCEPT;
+
     header_link set_link(const header& header, const context& ctx) NOEXCEPT;
     header_link set_link(const block& block, const context& ctx) NOEXCEPT;
     tx_link set_link(const transaction& tx) NOEXCEPT;
@@ -174,6 +215,8 @@ public:
 
     code get_block_state(const header_link& link) NOEXCEPT;
     code get_block_state(uint64_t& fees, const header_link& link) NOEXCEPT;
+    /// Results are cached per tx and context until the tx's state chain head
+    /// changes, so a repeated check costs one hashmap probe (no slab reads).
     code get_tx_state(const tx_link& link, const context& ctx) NOEXCEPT;
     code get_tx_state(uint64_t& fee, size_t& sigops, const tx_link& link,
         const context& ctx) NOEXCEPT;
@@ -219,27 +262,77 @@ public:
     bool pop_confirmed() NOEXCEPT;
     bool pop_candidate() NOEXCEPT;
 
+    /// Chain headers by height, decoded headers are cached by link (for chain
+    /// state, such as median time past and retargeting).
+    bool get_candidate_header(chain_header& out, size_t height) NOEXCEPT;
+    bool get_confirmed_header(chain_header& out, size_t height) NOEXCEPT;
+
     /// Optional Tables.
     /// -----------------------------------------------------------------------
 
-    /// Address hash function.
-    static hash_digest address_hash(const output& output) NOEXCEPT;
+    /// Address (natural-keyed by output script).
+    bool get_confirmed_balance(uint64_t& out, const script& script) NOEXCEPT;
+    bool to_address_outputs(output_links& out, const script& script) NOEXCEPT;
+    bool to_unspent_outputs(output_links& out, const script& script) NOEXCEPT;
+    bool to_minimum_unspent_outputs(output_links& out, const script& script,
+        uint64_t value) NOEXCEPT;
 
-    /// Address (natural-keyed).
-    bool get_confirmed_balance(uint64_t& out, const hash_digest& key) NOEXCEPT;
-    bool to_address_outputs(output_links& out, const hash_digest& key) NOEXCEPT;
-    bool to_unspent_outputs(output_links& out, const hash_digest& key) NOEXCEPT;
-    bool to_minimum_unspent_outputs(output_links& out, const hash_digest& key,
+    /// Coin selection, over confirmed unspent (possibly immature) outputs.
+    /// Value-ordered coins are built once per script and cached until the
+    /// confirmed chain changes. Minimum unspent outputs are ascending by value.
+    bool to_largest_unspent_outputs(output_links& out, const script& script,
+        size_t count) NOEXCEPT;
+    bool to_sufficient_unspent_output(output_link& out, const script& script,
         uint64_t value) NOEXCEPT;
-    bool set_address_output(const hash_digest& key,
+
+    /// Records the output as unconfirmed, its height is resolved on read
+    /// (stored heights are written only by the indexer).
+    bool set_address_output(const script& script,
         const output_link& link) NOEXCEPT;
 
+    /// Address history page (most recent first), at most limit outputs.
+    /// Cursor is terminal to start, and is set to the next element, or to
+    /// terminal when the history is exhausted. Pages do not reflect outputs
+    /// indexed after the first page. Height range is inclusive, and any
+    /// height restriction excludes outputs without a stored height.
+    bool to_address_page(output_links& out, address_link& cursor,
+        const script& script, size_t limit, size_t minimum=zero,
+        size_t maximum=max_size_t) NOEXCEPT;
+
+    /// Confirmed address history within the inclusive height range, ordered
+    /// by height (then by output), from the height stored with each element.
+    bool to_address_history(output_links& out, const script& script,
+        size_t minimum=zero, size_t maximum=max_size_t) NOEXCEPT;
+
+    /// Address indexer (confirmed height checkpoint).
+    /// Indexes up to limit confirmed blocks above the checkpoint, first
+    /// rewinding the checkpoint to the confirmed chain if reorganized. Call
+    /// repeatedly (e.g. from a background thread) to catch up, and following
+    /// push_confirmed to keep up. The checkpoint is the number of indexed
+    /// blocks, so the table may be enabled on an existing store. Concurrent
+    /// calls (from any query over the store) are serialized.
+    size_t get_address_checkpoint() NOEXCEPT;
+    bool index_addresses(size_t& indexed, size_t limit) NOEXCEPT;
+
+    /// Balance cache, maintained by the address indexer (confirmed value and
+    /// unspent output count of the script). False if the checkpoint is not
+    /// at the confirmed top, the script is not cached, or its id collides.
+    bool get_cached_balance(uint64_t& value, size_t& outputs,
+        const script& script) NOEXCEPT;
+
     /// Neutrino (surrogate-keyed).
     bool get_filter(filter& out, const header_link& link) NOEXCEPT;
     bool get_filter_head(hash_digest& out, const header_link& link) NOEXCEPT;
     bool set_filter(const header_link& link, const hash_digest& head,
         const filter& body) NOEXCEPT;
 
+    /// Neutrino range (confirmed height), false if any filter is not found.
+    /// Filter views are valid only within the handler, which must not write
+    /// to the store, and which may return false to terminate the iteration.
+    bool get_filters(size_t height, size_t count,
+        const filter_handler& handler) NOEXCEPT;
+    bool get_filter_heads(hashes& out, size_t height, size_t count) NOEXCEPT;
+
     /// Buffer (surrogate-keyed).
     transaction::cptr get_buffered_tx(const tx_link& link) NOEXCEPT;
     bool set_buffered_tx(const tx_link& link, const transaction& tx) NOEXCEPT;
@@ -251,8 +344,65 @@ public:
 protected:
     using input_key = table::input::search_key;
     using puts_link = table::puts::link;
+    using header_links = std_vector<header_link::integer>;
+    using coin = std::pair<uint64_t, output_link::integer>;
+    using coins = std_vector<coin>;
+    using coins_cptr = std::shared_ptr<const coins>;
+
+    struct address_puts
+    {
+        output_links links{};
+        std_vector<uint64_t> values{};
+        std_vector<system::data_chunk> scripts{};
+        std_vector<table::address::key> keys{};
+        std_vector<table::address::block::integer> heights{};
+    };
+
+    /// A tx state result for a context, current while the tx's state chain
+    /// head is unchanged. Fields are guarded by an odd/even sequence (seqlock).
+    struct tx_state_slot
+    {
+        std::atomic<uint64_t> sequence{};
+        std::atomic<tx_link::integer> tx{ tx_link::terminal };
+        std::atomic<table::validated_tx::link::integer> head{};
+        std::atomic<context::flag::integer> flags{};
+        std::atomic<context::block::integer> height{};
+        std::atomic<uint32_t> mtp{};
+        std::atomic<bool> validated{};
+        std::atomic<table::validated_tx::coding::integer> code{};
+        std::atomic<uint64_t> fee{};
+        std::atomic<table::validated_tx::sigop::integer> sigops{};
+    };
 
     height_link get_height(const header_link& link) NOEXCEPT;
+    bool to_candidates(header_links& out, size_t height,
+        size_t count) NOEXCEPT;
+    bool write_header(system::writer& sink, const header_link& link) NOEXCEPT;
+    bool unindex_addresses() NOEXCEPT;
+    bool get_address_puts(address_puts& created, address_puts& spent,
+        const header_links& blocks) NOEXCEPT;
+    bool get_address_puts(address_puts& puts) NOEXCEPT;
+    bool set_balances(const address_puts& created, const address_puts& spent,
+        bool confirm) NOEXCEPT;
+    bool set_unconfirmed(const address_puts& popped) NOEXCEPT;
+    bool get_address_height(size_t& out,
+        const table::address::record& address) NOEXCEPT;
+    bool set_collided(const address_puts& created,
+        const address_puts& spent) NOEXCEPT;
+    coins_cptr get_coins(const script& script) NOEXCEPT;
+    void set_associated(const header_link& link) NOEXCEPT;
+    void refresh() NOEXCEPT;
+    bool is_tx_state(const tx_link& link,
+        const table::validated_tx::slab& state) NOEXCEPT;
+    bool get_cached_tx_state(code& ec, uint64_t& fee, size_t& sigops,
+        const tx_link& link, const table::validated_tx::link& head,
+        const context& ctx) NOEXCEPT;
+    void set_cached_tx_state(const tx_link& link,
+        const table::validated_tx::link& head, const context& ctx,
+        const table::validated_tx::slab* state) NOEXCEPT;
+    bool get_chain_header(chain_header& out, size_t height,
+        bool candidate) NOEXCEPT;
+    bool get_cached_header(chain_header& out, const header_link& link) NOEXCEPT;
     input_links to_spenders(const table::input::search_key& key) NOEXCEPT;
     bool is_confirmed_unspent(const output_link& link) NOEXCEPT;
     bool is_mature_prevout(const point_link& link, size_t height) NOEXCEPT;
@@ -267,7 +417,43 @@ protected:
         const context& evaluated) NOEXCEPT;
 
 private:
+    // Candidate links read per batch when scanning for association.
+    static constexpr size_t candidate_batch = 1024;
+
+    // Outputs prefetched ahead of their read when indexing addresses.
+    static constexpr size_t prefetched_outputs = 16;
+
+    // Scripts cached before the coin cache is cleared.
+    static constexpr size_t coin_scripts = 1024;
+
+    // Headers cached before the header cache is cleared.
+    static constexpr size_t cached_headers = 8192;
+
+    // Tx states cached, each tx link maps to one slot (replaced on collision).
+    static constexpr size_t cached_tx_states = 4096;
+
     Store& store_;
+
+    // Store generation of the cached state, thread safe.
+    std::atomic<size_t> generation_{};
+
+    // These are protected by mutex.
+    std::map<system::data_chunk, coins_cptr> coins_{};
+    header_link coins_top_{};
+    size_t coins_count_{};
+    size_t coins_rows_{};
+    std::shared_mutex coins_mutex_{};
+    std::unordered_map<header_link::integer, chain_header> headers_{};
+    std::shared_mutex headers_mutex_{};
+    size_t fork_{};
+    header_link fork_confirmed_{};
+    header_link fork_candidate_{};
+    std::shared_mutex fork_mutex_{};
+    std_vector<bool> associated_{};
+    std::shared_mutex associated_mutex_{};
+
+    // These are lock free (each slot is guarded by its sequence).
+    std_vector<tx_state_slot> tx_states_;
 };
 
 } // namespace database
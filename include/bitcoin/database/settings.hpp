@@ -39,6 +39,23 @@ struct BCD_API settings
     /// Properties.
     std::filesystem::path path;
 
+    /// Allocate body file blocks on growth (not sparse).
+    bool preallocate;
+
+    /// Reserve the next body growth step in the background (if preallocate).
+    bool preallocate_ahead;
+
+    /// Write output values compressed by trailing decimal zeros.
+    bool compact_amounts;
+
+    /// Write input witnesses to the witness table (referenced by input).
+    /// The table files exist only when set, so must be set to reopen a store
+    /// created with it set.
+    bool separate_witness;
+
+    /// Write block tx fks as runs of consecutive fks.
+    bool compact_txs;
+
     /// Archives.
     /// -----------------------------------------------------------------------
 
@@ -57,6 +74,9 @@ struct BCD_API settings
     uint64_t output_size;
     uint16_t output_rate;
 
+    uint64_t witness_size;
+    uint16_t witness_rate;
+
     uint64_t puts_size;
     uint16_t puts_rate;
 
@@ -81,6 +101,9 @@ struct BCD_API settings
     uint64_t confirmed_size;
     uint16_t confirmed_rate;
 
+    uint64_t indexed_size;
+    uint16_t indexed_rate;
+
     uint32_t strong_tx_buckets;
     uint64_t strong_tx_size;
     uint16_t strong_tx_rate;
@@ -106,6 +129,10 @@ struct BCD_API settings
     uint32_t validated_tx_buckets;
     uint64_t validated_tx_size;
     uint16_t validated_tx_rate;
+
+    uint32_t balance_buckets;
+    uint64_t balance_size;
+    uint16_t balance_rate;
 };
 
 } // namespace database
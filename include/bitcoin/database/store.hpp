@@ -19,7 +19,9 @@
 #ifndef LIBBITCOIN_DATABASE_TABLES_STORE_HPP
 #define LIBBITCOIN_DATABASE_TABLES_STORE_HPP
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <shared_mutex>
 #include <bitcoin/database/boost.hpp>
 #include <bitcoin/database/define.hpp>
@@ -35,7 +37,9 @@
 #include <bitcoin/database/tables/archives/puts.hpp>
 #include <bitcoin/database/tables/archives/transaction.hpp>
 #include <bitcoin/database/tables/archives/txs.hpp>
+#include <bitcoin/database/tables/archives/witness.hpp>
 
+#include <bitcoin/database/tables/caches/balance.hpp>
 #include <bitcoin/database/tables/caches/bootstrap.hpp>
 #include <bitcoin/database/tables/caches/buffer.hpp>
 #include <bitcoin/database/tables/caches/neutrino.hpp>
@@ -59,6 +63,7 @@ public:
     DELETE_COPY_MOVE_DESTRUCT(store);
 
     using transactor = std::shared_lock<boost::upgrade_mutex>;
+    using indexer = std::unique_lock<std::mutex>;
 
     /// Construct a store from settings.
     store(const settings& config) NOEXCEPT;
@@ -72,6 +77,13 @@ public:
     /// Snapshot the set of tables (from loaded).
     code snapshot() NOEXCEPT;
 
+    /// Snapshot the set of tables (from loaded). Writers are blocked for head
+    /// capture and for a full flush of each body updated in place (address,
+    /// balance, bootstrap and the height indexes), so the stall grows with
+    /// the unflushed size of those tables. Appended bodies are flushed after
+    /// writers resume. Not thread safe with respect to concurrent snapshots.
+    code hot_snapshot() NOEXCEPT;
+
     /// Restore the most recent snapshot (from unloaded).
     code restore() NOEXCEPT;
 
@@ -81,11 +93,20 @@ public:
     /// Get a transactor object.
     const transactor get_transactor() NOEXCEPT;
 
+    /// Get an indexer object, held for the whole of an address index batch
+    /// so that concurrent indexers cannot apply the same batch twice.
+    const indexer get_indexer() NOEXCEPT;
+
+    /// Incremented by each successful create and open, so that state derived
+    /// from table contents (such as query caches) can detect replacement.
+    size_t generation() const NOEXCEPT;
+
     /// Archives.
     table::header header;
     table::point point;
     table::input input;
     table::output output;
+    table::witness witness;
     table::puts puts;
     table::transaction tx;
     table::txs txs;
@@ -94,6 +115,7 @@ public:
     table::address address;
     table::height candidate;
     table::height confirmed;
+    table::height indexed;
     table::strong_tx strong_tx;
 
     /// Caches.
@@ -102,12 +124,26 @@ public:
     table::neutrino neutrino;
     table::validated_bk validated_bk;
     table::validated_tx validated_tx;
+    table::balance balance;
 
 protected:
+    using buffers = std_vector<system::data_chunk>;
+
+    bool write_version() NOEXCEPT;
+    bool read_version() NOEXCEPT;
     code open_load() NOEXCEPT;
     code unload_close() NOEXCEPT;
+    code flush_bodies() NOEXCEPT;
+    code flush_updated_bodies() NOEXCEPT;
+    code flush_appended_bodies() NOEXCEPT;
+    code backup_tables() NOEXCEPT;
     code backup() NOEXCEPT;
+    code backup(const buffers& heads) NOEXCEPT;
+    code rotate() NOEXCEPT;
+    code copy(buffers& heads) NOEXCEPT;
     code dump(const std::filesystem::path& folder) NOEXCEPT;
+    code dump(const std::filesystem::path& folder,
+        const buffers& heads) NOEXCEPT;
 
     // These are thread safe.
     const settings& configuration_;
@@ -131,6 +167,10 @@ protected:
     Storage output_head_;
     Storage output_body_;
 
+    // blob
+    Storage witness_head_;
+    Storage witness_body_;
+
     // array
     Storage puts_head_;
     Storage puts_body_;
@@ -158,6 +198,10 @@ protected:
     Storage confirmed_head_;
     Storage confirmed_body_;
 
+    // array
+    Storage indexed_head_;
+    Storage indexed_body_;
+
     // record hashmap
     Storage strong_tx_head_;
     Storage strong_tx_body_;
@@ -185,6 +229,10 @@ protected:
     Storage validated_tx_head_;
     Storage validated_tx_body_;
 
+    // record hashmap
+    Storage balance_head_;
+    Storage balance_body_;
+
     /// Locks.
     /// -----------------------------------------------------------------------
 
@@ -192,6 +240,10 @@ protected:
     flush_lock flush_lock_;
     interprocess_lock process_lock_;
     boost::upgrade_mutex transactor_mutex_;
+    std::mutex indexer_mutex_;
+
+    // This is thread safe.
+    std::atomic<size_t> generation_{};
 
 private:
     using path = std::filesystem::path;
@@ -210,6 +262,11 @@ private:
     {
         return folder / (name + schema::ext::lock);
     }
+
+    static inline path version(const path& folder) NOEXCEPT
+    {
+        return folder / schema::version::file;
+    }
 };
 
 } // namespace database
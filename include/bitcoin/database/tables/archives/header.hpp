@@ -37,6 +37,75 @@ struct header
     using search_key = search<schema::hash>;
     using hash_map<schema::header>::hashmap;
 
+    /// Zero-copy field access to a record in the mapped body.
+    struct view
+      : public hash_view<schema::header>
+    {
+        using hash_view<schema::header>::view;
+        using flag = context::flag;
+        using block = context::block;
+
+        static constexpr size_t to_height = flag::size;
+        static constexpr size_t to_mtp = to_height + block::size;
+        static constexpr size_t to_parent = context::size;
+        static constexpr size_t to_version = to_parent + link::size;
+        static constexpr size_t to_timestamp = to_version + sizeof(uint32_t);
+        static constexpr size_t to_bits = to_timestamp + sizeof(uint32_t);
+        static constexpr size_t to_nonce = to_bits + sizeof(uint32_t);
+        static constexpr size_t to_root = to_nonce + sizeof(uint32_t);
+        static_assert(to_root + schema::hash == schema::header::minsize);
+
+        inline flag::integer flags() const NOEXCEPT
+        {
+            return read_little_endian<zero, flag::integer, flag::size>();
+        }
+
+        inline block::integer height() const NOEXCEPT
+        {
+            return read_little_endian<to_height, block::integer, block::size>();
+        }
+
+        inline uint32_t mtp() const NOEXCEPT
+        {
+            return read_little_endian<to_mtp, uint32_t>();
+        }
+
+        inline context ctx() const NOEXCEPT
+        {
+            return { flags(), height(), mtp() };
+        }
+
+        inline link::integer parent_fk() const NOEXCEPT
+        {
+            return read_little_endian<to_parent, link::integer, link::size>();
+        }
+
+        inline uint32_t version() const NOEXCEPT
+        {
+            return read_little_endian<to_version, uint32_t>();
+        }
+
+        inline uint32_t timestamp() const NOEXCEPT
+        {
+            return read_little_endian<to_timestamp, uint32_t>();
+        }
+
+        inline uint32_t bits() const NOEXCEPT
+        {
+            return read_little_endian<to_bits, uint32_t>();
+        }
+
+        inline uint32_t nonce() const NOEXCEPT
+        {
+            return read_little_endian<to_nonce, uint32_t>();
+        }
+
+        inline hash_digest merkle_root() const NOEXCEPT
+        {
+            return read_hash<to_root>();
+        }
+    };
+
     struct record
       : public schema::header
     {        
@@ -23,6 +23,8 @@
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/memory/memory.hpp>
 #include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/tables/archives/witness.hpp>
+#include <bitcoin/database/tables/compression.hpp>
 #include <bitcoin/database/tables/schema.hpp>
 
 namespace libbitcoin {
@@ -31,14 +33,57 @@ namespace table {
 
 /// Input is searchable by point_fk/index (fP) of the output that it spends.
 /// This makes input a multimap, as multiple inputs can spend a given output.
+/// Witness is stored inline or as a reference to the witness table (wx). A
+/// witness element count never requires an eight byte varint, so that prefix
+/// marks a reference, and is followed by the witness link.
 struct input
   : public hash_map<schema::input>
 {
     using tx = linkage<schema::tx>;
     using ix = linkage<schema::index>;
+    using wx = linkage<schema::witness::pk>;
     using hash_map<schema::input>::hashmap;
     using search_key = search<schema::input::sk>;
 
+    static constexpr uint8_t witness_reference = system::varint_eight_bytes;
+
+    static inline size_t witness_size(const system::chain::witness& witness,
+        wx::integer witness_fk) NOEXCEPT
+    {
+        return witness_fk == wx::terminal ? witness.serialized_size(true) :
+            sizeof(uint8_t) + wx::size;
+    }
+
+    template <typename Sink>
+    static inline void witness_to_data(Sink& sink,
+        const system::chain::witness& witness, wx::integer witness_fk) NOEXCEPT
+    {
+        if (witness_fk == wx::terminal)
+        {
+            witness.to_data(sink, true);
+            return;
+        }
+
+        sink.write_byte(witness_reference);
+        sink.template write_little_endian<wx::integer, wx::size>(witness_fk);
+    }
+
+    /// Returns witness link, or terminal (and reads witness) if inline.
+    template <typename Source>
+    static inline wx::integer witness_from_data(Source& source,
+        system::chain::witness& witness) NOEXCEPT
+    {
+        if (source.peek_byte() != witness_reference)
+        {
+            witness = system::chain::witness(source, true);
+            return wx::terminal;
+        }
+
+        source.skip_byte();
+        witness = {};
+        return source.template read_little_endian<wx::integer, wx::size>();
+    }
+
     // Composers/decomposers do not adjust to type changes.
     static_assert(tx::size == 4 && ix::size == 3);
 
@@ -82,16 +127,16 @@ struct input
                 variable_size(index) +
                 sizeof(uint32_t) +
                 script.serialized_size(true) +
-                witness.serialized_size(true));
+                witness_size(witness, witness_fk));
         }
 
         inline bool from_data(reader& source) NOEXCEPT
         {
-            parent_fk = source.read_little_endian<tx::integer, tx::size>();
-            index     = system::narrow_cast<ix::integer>(source.read_variable());
-            sequence  = source.read_little_endian<uint32_t>();
-            script    = system::chain::script(source, true);
-            witness   = system::chain::witness(source, true);
+            parent_fk  = source.read_little_endian<tx::integer, tx::size>();
+            index      = system::narrow_cast<ix::integer>(source.read_variable());
+            sequence   = source.read_little_endian<uint32_t>();
+            script     = system::chain::script(source, true);
+            witness_fk = witness_from_data(source, witness);
             BC_ASSERT(source.get_read_position() == count());
             return source;
         }
@@ -102,7 +147,7 @@ struct input
             sink.write_variable(index);
             sink.write_little_endian<uint32_t>(sequence);
             script.to_data(sink, true);
-            witness.to_data(sink, true);
+            witness_to_data(sink, witness, witness_fk);
             BC_ASSERT(sink.get_write_position() == count());
             return sink;
         }
@@ -113,7 +158,8 @@ struct input
                 && index == other.index
                 && sequence == other.sequence
                 && script == other.script
-                && witness == other.witness;
+                && witness == other.witness
+                && witness_fk == other.witness_fk;
         }
 
         tx::integer parent_fk{};
@@ -121,6 +167,7 @@ struct input
         uint32_t sequence{};
         system::chain::script script{};
         system::chain::witness witness{};
+        wx::integer witness_fk{ wx::terminal };
     };
 
     // Cannot return complete input because input.point is not available.
@@ -134,13 +181,23 @@ struct input
             source.skip_variable();
             sequence = source.read_little_endian<uint32_t>();
             script = to_shared<chain::script>(source, true);
-            witness = to_shared<chain::witness>(source, true);
+
+            // Referenced witness is left empty for caller resolution.
+            chain::witness value{};
+            witness_fk = witness_from_data(source, value);
+            witness = to_shared<chain::witness>(std::move(value));
             return source;
         }
+
+        inline bool is_external() const NOEXCEPT
+        {
+            return witness_fk != wx::terminal;
+        }
     
         uint32_t sequence{};
         system::chain::script::cptr script{};
         system::chain::witness::cptr witness{};
+        wx::integer witness_fk{ wx::terminal };
     };
 
     struct only_with_decomposed_sk
@@ -182,25 +239,96 @@ struct input
     
             // sequence stored out of order (prefer script/witness trailing).
             const auto sequence = source.read_little_endian<uint32_t>();
+            const auto script = to_shared<chain::script>(source, true);
 
-            // Parameter evaluation order is not assured by c++ (use new).
-            BC_PUSH_WARNING(NO_NEW_OR_DELETE)
-            BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
-            input = to_shared(new chain::input
-            {
+            // Referenced witness is left empty for caller resolution.
+            chain::witness witness{};
+            witness_fk = witness_from_data(source, witness);
+
+            input = to_shared<chain::input>
+            (
                 prevout,
-                to_shared<chain::script>(source, true),
-                to_shared<chain::witness>(source, true),
+                script,
+                to_shared<chain::witness>(std::move(witness)),
                 sequence
-            });
-            BC_POP_WARNING()
-            BC_POP_WARNING()
-    
+            );
+
             return source;
         }
     
         const system::chain::point::cptr prevout{};
         system::chain::input::cptr input{};
+        wx::integer witness_fk{ wx::terminal };
+    };
+
+    // Copies wire input to sink, with point hash obtained from point fk.
+    template <typename Resolver>
+    struct wire
+      : public schema::input
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            using namespace system;
+            source.rewind_bytes(sk);
+            const auto point_fk = source.read_little_endian<tx::integer, tx::size>();
+            const auto point_index = source.read_little_endian<ix::integer, ix::size>();
+
+            // Restore null point (see slab_decomposed_sk).
+            if (point_fk == tx::terminal)
+            {
+                sink.write_bytes(null_hash);
+                sink.write_4_bytes_little_endian(chain::point::null_index);
+            }
+            else
+            {
+                sink.write_bytes(resolve(point_fk));
+                sink.write_4_bytes_little_endian(point_index);
+            }
+
+            source.skip_bytes(tx::size);
+            source.skip_variable();
+            const auto sequence = source.read_4_bytes_little_endian();
+            const auto size = source.read_size();
+            sink.write_variable(size);
+            compression::copy_bytes(source, sink, size);
+            sink.write_4_bytes_little_endian(sequence);
+            return source;
+        }
+
+        system::writer& sink;
+        const Resolver& resolve;
+    };
+
+    // Copies inline wire witness to sink, or returns reference for caller.
+    struct wire_witness
+      : public schema::input
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            source.skip_bytes(tx::size);
+            source.skip_variable();
+            source.skip_bytes(sizeof(uint32_t));
+            source.skip_bytes(source.read_size());
+
+            if (source.peek_byte() == witness_reference)
+            {
+                source.skip_byte();
+                witness_fk = source.read_little_endian<wx::integer, wx::size>();
+                return source;
+            }
+
+            witness::copy(source, sink);
+            witness_fk = wx::terminal;
+            return source;
+        }
+
+        inline bool is_external() const NOEXCEPT
+        {
+            return witness_fk != wx::terminal;
+        }
+
+        system::writer& sink;
+        wx::integer witness_fk{ wx::terminal };
     };
 
     struct get_parent
@@ -225,7 +353,7 @@ struct input
                 variable_size(index) +
                 sizeof(uint32_t) +
                 input.script().serialized_size(true) +
-                input.witness().serialized_size(true));
+                witness_size(input.witness(), witness_fk));
         }
 
         // Cannot use input.to_date(sink) because it includes input.point.
@@ -235,7 +363,7 @@ struct input
             sink.write_variable(index);
             sink.write_little_endian<uint32_t>(input.sequence());
             input.script().to_data(sink, true);
-            input.witness().to_data(sink, true);
+            witness_to_data(sink, input.witness(), witness_fk);
             BC_ASSERT(sink.get_write_position() == count());
             return sink;
         }
@@ -243,6 +371,7 @@ struct input
         tx::integer parent_fk{};
         ix::integer index{};
         const system::chain::input& input{};
+        wx::integer witness_fk{ wx::terminal };
     };
 
     struct slab_composite_sk
@@ -23,6 +23,7 @@
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/memory/memory.hpp>
 #include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/tables/compression.hpp>
 #include <bitcoin/database/tables/schema.hpp>
 
 namespace libbitcoin {
@@ -31,12 +32,24 @@ namespace table {
 
 /// Output is a blob (set of non-searchable slabs).
 /// Output can be obtained by fk navigation (eg from tx/index). 
+/// Script is compressed by template, and value is optionally compressed by
+/// trailing decimal zeros (see compression). Either value form is readable.
 struct output
   : public array_map<schema::output>
 {
     using tx = linkage<schema::tx>;
     using ix = linkage<schema::index>;
-    using array_map<schema::output>::arraymap;
+
+    output(storage& header, storage& body, bool compact=false) NOEXCEPT
+      : array_map<schema::output>(header, body), compact_(compact)
+    {
+    }
+
+    /// True if values are written in compact form.
+    bool compact() const NOEXCEPT
+    {
+        return compact_;
+    }
 
     struct slab
       : public schema::output
@@ -46,8 +59,8 @@ struct output
             return system::possible_narrow_cast<link::integer>(
                 tx::size +
                 variable_size(index) +
-                variable_size(value) +
-                script.serialized_size(true));
+                compression::amount_size(value, compact) +
+                compression::script_size(script));
         }
 
         inline bool from_data(reader& source) NOEXCEPT
@@ -55,8 +68,14 @@ struct output
             using namespace system;
             parent_fk = source.read_little_endian<tx::integer, tx::size>();
             index     = narrow_cast<ix::integer>(source.read_variable());
-            value     = source.read_variable();
-            script    = chain::script(source, true);
+
+            // The compact form is used only if smaller, so size identifies it.
+            const auto start = source.get_read_position();
+            value     = compression::amount_from_data(source);
+            compact   = (source.get_read_position() - start) !=
+                variable_size(value);
+
+            script    = compression::script_from_data(source);
             BC_ASSERT(source.get_read_position() == count());
             return source;
         }
@@ -65,8 +84,8 @@ struct output
         {
             sink.write_little_endian<tx::integer, tx::size>(parent_fk);
             sink.write_variable(index);
-            sink.write_variable(value);
-            script.to_data(sink, true);
+            compression::amount_to_data(sink, value, compact);
+            compression::script_to_data(sink, script);
             BC_ASSERT(sink.get_write_position() == count());
             return sink;
         }
@@ -83,6 +102,7 @@ struct output
         ix::integer index{};
         uint64_t value{};
         system::chain::script script{};
+        bool compact{};
     };
 
     // Cannot use output{ sink } because database output.value is varint.
@@ -100,8 +120,8 @@ struct output
             BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
             output = to_shared(new chain::output
             {
-                source.read_variable(),
-                to_shared<chain::script>(source, true)
+                compression::amount_from_data(source),
+                to_shared<chain::script>(compression::script_from_data(source))
             });
             BC_POP_WARNING()
             BC_POP_WARNING()
@@ -112,6 +132,23 @@ struct output
         system::chain::output::cptr output{};
     };
 
+    // Copies wire output to sink, without chain objects.
+    struct wire
+      : public schema::output
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            source.skip_bytes(tx::size);
+            source.skip_variable();
+            sink.write_8_bytes_little_endian(
+                compression::amount_from_data(source));
+            compression::script_to_wire(source, sink);
+            return source;
+        }
+
+        system::writer& sink;
+    };
+
     struct get_value
       : public schema::output
     {
@@ -119,13 +156,56 @@ struct output
         {
             source.skip_bytes(tx::size);
             source.skip_variable();
-            value = source.read_variable();
+            value = compression::amount_from_data(source);
             return source;
         }
 
         uint64_t value{};
     };
 
+    // Copies value and stored (compressed) script bytes, without parsing.
+    struct get_compressed
+      : public schema::output
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            source.skip_bytes(tx::size);
+            source.skip_variable();
+            value = compression::amount_from_data(source);
+            script = compression::script_data(source);
+            return source;
+        }
+
+        uint64_t value{};
+        system::data_chunk script{};
+    };
+
+    // Compares stored (compressed) script to compressed script bytes.
+    struct get_script_match
+      : public schema::output
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            source.skip_bytes(tx::size);
+            source.skip_variable();
+
+            // Raw and compact amounts are both varint-shaped.
+            source.skip_variable();
+
+            // Compressed script is size-prefixed, so prefix match is exact.
+            match = std::all_of(script.begin(), script.end(),
+                [&](uint8_t byte) NOEXCEPT
+                {
+                    return source.read_byte() == byte;
+                });
+
+            return source;
+        }
+
+        const system::data_chunk& script;
+        bool match{};
+    };
+
     struct get_parent
       : public schema::output
     {
@@ -161,16 +241,16 @@ struct output
             return system::possible_narrow_cast<link::integer>(
                 tx::size +
                 variable_size(index) +
-                variable_size(output.value()) +
-                output.script().serialized_size(true));
+                compression::amount_size(output.value(), compact) +
+                compression::script_size(output.script()));
         }
 
         inline bool to_data(writer& sink) const NOEXCEPT
         {
             sink.write_little_endian<tx::integer, tx::size>(parent_fk);
             sink.write_variable(index);
-            sink.write_variable(output.value());
-            output.script().to_data(sink, true);
+            compression::amount_to_data(sink, output.value(), compact);
+            compression::script_to_data(sink, output.script());
             BC_ASSERT(sink.get_write_position() == count());
             return sink;
         }
@@ -178,7 +258,11 @@ struct output
         tx::integer parent_fk{};
         ix::integer index{};
         const system::chain::output& output{};
+        bool compact{};
     };
+
+private:
+    const bool compact_;
 };
 
 } // namespace table
@@ -47,6 +47,68 @@ struct transaction
         sizeof(uint32_t) +
         sizeof(uint32_t);
 
+    /// Zero-copy field access to a record in the mapped body.
+    struct view
+      : public hash_view<schema::transaction>
+    {
+        using hash_view<schema::transaction>::view;
+
+        static constexpr size_t to_light = schema::bit;
+        static constexpr size_t to_heavy = to_light + bytes::size;
+        static constexpr size_t to_locktime = to_heavy + bytes::size;
+        static constexpr size_t to_version = to_locktime + sizeof(uint32_t);
+        static constexpr size_t to_ins_count = to_version + sizeof(uint32_t);
+        static constexpr size_t to_outs_count = to_ins_count + ix::size;
+        static constexpr size_t to_ins_fk = to_outs_count + ix::size;
+        static_assert(to_ins_count == skip_to_puts);
+        static_assert(to_ins_fk + puts::size == schema::transaction::minsize);
+
+        inline bool coinbase() const NOEXCEPT
+        {
+            return to_bool(read_byte<zero>());
+        }
+
+        inline bytes::integer light() const NOEXCEPT
+        {
+            return read_little_endian<to_light, bytes::integer, bytes::size>();
+        }
+
+        inline bytes::integer heavy() const NOEXCEPT
+        {
+            return read_little_endian<to_heavy, bytes::integer, bytes::size>();
+        }
+
+        inline uint32_t locktime() const NOEXCEPT
+        {
+            return read_little_endian<to_locktime, uint32_t>();
+        }
+
+        inline uint32_t version() const NOEXCEPT
+        {
+            return read_little_endian<to_version, uint32_t>();
+        }
+
+        inline ix::integer ins_count() const NOEXCEPT
+        {
+            return read_little_endian<to_ins_count, ix::integer, ix::size>();
+        }
+
+        inline ix::integer outs_count() const NOEXCEPT
+        {
+            return read_little_endian<to_outs_count, ix::integer, ix::size>();
+        }
+
+        inline puts::integer ins_fk() const NOEXCEPT
+        {
+            return read_little_endian<to_ins_fk, puts::integer, puts::size>();
+        }
+
+        inline puts::integer outs_fk() const NOEXCEPT
+        {
+            return ins_fk() + ins_count();
+        }
+    };
+
     struct record
       : public schema::transaction
     {
@@ -31,12 +31,77 @@ namespace database {
 namespace table {
 
 /// Txs is a slab hashmap of tx fks (first is count), searchable by header.fk.
+/// Tx fks are optionally compacted as runs of consecutive fks. The high bit
+/// of count (never otherwise set) indicates compaction, in which case each
+/// run is a zigzag varint delta of its first fk from the end of the previous
+/// run (initially zero), followed by a varint of its length less one.
 struct txs
   : public hash_map<schema::txs>
 {
     using tx = linkage<schema::tx>;
     using keys = std_vector<tx::integer>;
-    using hash_map<schema::txs>::hashmap;
+
+    static constexpr auto compact_bit = system::power2<tx::integer>(
+        sub1(to_bits(tx::size)));
+
+    txs(storage& header, storage& body, const link& buckets,
+        bool compact=false) NOEXCEPT
+      : hash_map<schema::txs>(header, body, buckets), compact_(compact)
+    {
+    }
+
+    /// True if tx fks are written in compact form.
+    bool compact() const NOEXCEPT
+    {
+        return compact_;
+    }
+
+    static constexpr uint64_t to_zigzag(tx::integer value,
+        tx::integer expected) NOEXCEPT
+    {
+        return value < expected ?
+            system::sub1(uint64_t{ expected - value } << 1) :
+            uint64_t{ value - expected } << 1;
+    }
+
+    static constexpr tx::integer from_zigzag(uint64_t delta,
+        tx::integer expected) NOEXCEPT
+    {
+        using namespace system;
+        const auto magnitude = possible_narrow_cast<tx::integer>(
+            add1(delta) >> 1);
+        return is_odd(delta) ? expected - magnitude : expected + magnitude;
+    }
+
+    /// Iterate runs as (first, length) of non-empty fks.
+    template <typename Handler>
+    static inline void for_each_run(const keys& fks, Handler&& handler) NOEXCEPT
+    {
+        for (auto it = fks.begin(); it != fks.end();)
+        {
+            const auto first = *it;
+            tx::integer length{ 1 };
+            while (++it != fks.end() && *it == first + length)
+                ++length;
+
+            handler(first, length);
+        }
+    }
+
+    static inline size_t compact_size(const keys& fks) NOEXCEPT
+    {
+        using namespace system;
+        size_t size{};
+        tx::integer expected{};
+        for_each_run(fks, [&](tx::integer first, tx::integer length) NOEXCEPT
+        {
+            size += variable_size(to_zigzag(first, expected));
+            size += variable_size(sub1(length));
+            expected = first + length;
+        });
+
+        return size;
+    }
 
     struct slab
       : public schema::txs
@@ -44,16 +109,49 @@ struct txs
         link count() const NOEXCEPT
         {
             return system::possible_narrow_cast<link::integer>(pk + sk +
-                tx::size * add1(tx_fks.size()));
+                tx::size + (compact ? compact_size(tx_fks) :
+                    tx::size * tx_fks.size()));
         }
 
         inline bool from_data(reader& source) NOEXCEPT
         {
-            tx_fks.resize(source.read_little_endian<tx::integer, tx::size>());
-            std::for_each(tx_fks.begin(), tx_fks.end(), [&](auto& fk) NOEXCEPT
+            const auto fks = source.read_little_endian<tx::integer, tx::size>();
+            if (system::is_zero(fks & compact_bit))
+            {
+                compact = false;
+                tx_fks.resize(fks);
+                std::for_each(tx_fks.begin(), tx_fks.end(), [&](auto& fk) NOEXCEPT
+                {
+                    fk = source.read_little_endian<tx::integer, tx::size>();
+                });
+            }
+            else
             {
-                fk = source.read_little_endian<tx::integer, tx::size>();
-            });
+                using namespace system;
+                compact = true;
+                const size_t total = fks & ~compact_bit;
+                tx_fks.clear();
+                tx_fks.reserve(total);
+                tx::integer expected{};
+                while (tx_fks.size() < total && source)
+                {
+                    const auto first = from_zigzag(source.read_variable(),
+                        expected);
+                    const auto length = add1(possible_narrow_cast<tx::integer>(
+                        source.read_variable()));
+
+                    if (length > total - tx_fks.size())
+                    {
+                        source.invalidate();
+                        break;
+                    }
+
+                    for (tx::integer offset{}; offset < length; ++offset)
+                        tx_fks.push_back(first + offset);
+
+                    expected = first + length;
+                }
+            }
 
             BC_ASSERT(source.get_read_position() == count());
             return source;
@@ -61,14 +159,29 @@ struct txs
 
         inline bool to_data(finalizer& sink) const NOEXCEPT
         {
-            BC_ASSERT(tx_fks.size() < system::power2<uint64_t>(to_bits(tx::size)));
-            const auto fks = system::possible_narrow_cast<tx::integer>(tx_fks.size());
+            using namespace system;
+            BC_ASSERT(tx_fks.size() < compact_bit);
+            const auto fks = possible_narrow_cast<tx::integer>(tx_fks.size());
 
-            sink.write_little_endian<tx::integer, tx::size>(fks);
-            std::for_each(tx_fks.begin(), tx_fks.end(), [&](const auto& fk) NOEXCEPT
+            if (!compact)
             {
-                sink.write_little_endian<tx::integer, tx::size>(fk);
-            });
+                sink.write_little_endian<tx::integer, tx::size>(fks);
+                std::for_each(tx_fks.begin(), tx_fks.end(), [&](const auto& fk) NOEXCEPT
+                {
+                    sink.write_little_endian<tx::integer, tx::size>(fk);
+                });
+            }
+            else
+            {
+                tx::integer expected{};
+                sink.write_little_endian<tx::integer, tx::size>(fks | compact_bit);
+                for_each_run(tx_fks, [&](tx::integer first, tx::integer length) NOEXCEPT
+                {
+                    sink.write_variable(to_zigzag(first, expected));
+                    sink.write_variable(sub1(length));
+                    expected = first + length;
+                });
+            }
 
             BC_ASSERT(sink.get_write_position() == count());
             return sink;
@@ -80,6 +193,7 @@ struct txs
         }
 
         keys tx_fks{};
+        bool compact{};
     };
 
     struct slab_position
@@ -88,9 +202,35 @@ struct txs
         inline bool from_data(reader& source) NOEXCEPT
         {
             const auto count = source.read_little_endian<tx::integer, tx::size>();
-            for (position = zero; position < count; ++position)
-                if (source.read_little_endian<tx::integer, tx::size>() == link)
+            if (system::is_zero(count & compact_bit))
+            {
+                for (position = zero; position < count; ++position)
+                    if (source.read_little_endian<tx::integer, tx::size>() == link)
+                        return source;
+
+                source.invalidate();
+                return source;
+            }
+
+            // Runs are searched arithmetically, without expansion.
+            using namespace system;
+            tx::integer expected{};
+            for (position = zero; position < (count & ~compact_bit) && source;)
+            {
+                const auto first = from_zigzag(source.read_variable(),
+                    expected);
+                const auto length = add1(possible_narrow_cast<tx::integer>(
+                    source.read_variable()));
+
+                if (link >= first && link - first < length)
+                {
+                    position += (link - first);
                     return source;
+                }
+
+                position += length;
+                expected = first + length;
+            }
 
             source.invalidate();
             return source;
@@ -99,6 +239,9 @@ struct txs
         const tx::integer link{};
         size_t position{};
     };
+
+private:
+    const bool compact_;
 };
 
 } // namespace table
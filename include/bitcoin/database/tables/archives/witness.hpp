@@ -0,0 +1,146 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_TABLES_ARCHIVES_WITNESS_HPP
+#define LIBBITCOIN_DATABASE_TABLES_ARCHIVES_WITNESS_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/memory/memory.hpp>
+#include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/tables/compression.hpp>
+#include <bitcoin/database/tables/schema.hpp>
+
+namespace libbitcoin {
+namespace database {
+namespace table {
+
+/// Witness is a blob (set of non-searchable slabs).
+/// Witness is obtained by fk navigation from input (when stored externally).
+struct witness
+  : public array_map<schema::witness>
+{
+    witness(storage& header, storage& body, bool enabled=false) NOEXCEPT
+      : array_map<schema::witness>(header, body), enabled_(enabled)
+    {
+    }
+
+    /// True if input witnesses are written to this table.
+    bool enabled() const NOEXCEPT
+    {
+        return enabled_;
+    }
+
+    /// Copy serialized (prefixed) witness from source to sink.
+    template <typename Source, typename Sink>
+    static inline void copy(Source& source, Sink& sink) NOEXCEPT
+    {
+        const auto count = source.read_size();
+        sink.write_variable(count);
+        for (size_t element = 0; element < count && source; ++element)
+        {
+            const auto size = source.read_size();
+            sink.write_variable(size);
+            compression::copy_bytes(source, sink, size);
+        }
+    }
+
+    struct slab
+      : public schema::witness
+    {
+        link count() const NOEXCEPT
+        {
+            return system::possible_narrow_cast<link::integer>(
+                witness.serialized_size(true));
+        }
+
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            witness = system::chain::witness(source, true);
+            BC_ASSERT(source.get_read_position() == count());
+            return source;
+        }
+
+        inline bool to_data(writer& sink) const NOEXCEPT
+        {
+            witness.to_data(sink, true);
+            BC_ASSERT(sink.get_write_position() == count());
+            return sink;
+        }
+
+        inline bool operator==(const slab& other) const NOEXCEPT
+        {
+            return witness == other.witness;
+        }
+
+        system::chain::witness witness{};
+    };
+
+    struct only
+      : public schema::witness
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            witness = system::to_shared<system::chain::witness>(source, true);
+            return source;
+        }
+
+        system::chain::witness::cptr witness{};
+    };
+
+    // Copies wire witness to sink, without chain objects.
+    struct wire
+      : public schema::witness
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            copy(source, sink);
+            return source;
+        }
+
+        system::writer& sink;
+    };
+
+    struct slab_put_ref
+      : public schema::witness
+    {
+        link count() const NOEXCEPT
+        {
+            return system::possible_narrow_cast<link::integer>(
+                witness.serialized_size(true));
+        }
+
+        inline bool to_data(writer& sink) const NOEXCEPT
+        {
+            witness.to_data(sink, true);
+            BC_ASSERT(sink.get_write_position() == count());
+            return sink;
+        }
+
+        const system::chain::witness& witness{};
+    };
+
+private:
+    const bool enabled_;
+};
+
+} // namespace table
+} // namespace database
+} // namespace libbitcoin
+
+#endif
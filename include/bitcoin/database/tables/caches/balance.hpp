@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_TABLES_CACHES_BALANCE_HPP
+#define LIBBITCOIN_DATABASE_TABLES_CACHES_BALANCE_HPP
+
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/tables/schema.hpp>
+
+namespace libbitcoin {
+namespace database {
+namespace table {
+
+/// balance is a record hashmap of confirmed value and unspent output count,
+/// keyed by address script id and updated in place as blocks are indexed.
+/// The output fk identifies the script of the key, and is terminal once
+/// a distinct script is found with the same id (cache is then unusable).
+struct balance
+  : public hash_map<schema::balance>
+{
+    using out = linkage<schema::put>;
+    using hash_map<schema::balance>::hashmap;
+
+    struct record
+      : public schema::balance
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            output_fk = source.read_little_endian<out::integer, out::size>();
+            value = source.read_8_bytes_little_endian();
+            outputs = source.read_4_bytes_little_endian();
+            return source;
+        }
+
+        inline bool to_data(finalizer& sink) const NOEXCEPT
+        {
+            sink.write_little_endian<out::integer, out::size>(output_fk);
+            sink.write_8_bytes_little_endian(value);
+            sink.write_4_bytes_little_endian(outputs);
+            return sink;
+        }
+
+        inline bool operator==(const record& other) const NOEXCEPT
+        {
+            return output_fk == other.output_fk
+                && value == other.value
+                && outputs == other.outputs;
+        }
+
+        inline bool is_collided() const NOEXCEPT
+        {
+            return output_fk == out::terminal;
+        }
+
+        out::integer output_fk{};
+        uint64_t value{};
+        uint32_t outputs{};
+    };
+};
+
+} // namespace table
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -34,6 +34,18 @@ struct bootstrap
 {
     using array_map<schema::bootstrap>::arraymap;
 
+    /// Zero-copy access to one block hash record in the mapped body.
+    struct view
+      : public array_view<schema::bootstrap>
+    {
+        using array_view<schema::bootstrap>::view;
+
+        inline hash_digest block_hash() const NOEXCEPT
+        {
+            return read_hash<zero>();
+        }
+    };
+
     struct record
       : public schema::bootstrap
     {
@@ -34,6 +34,40 @@ struct neutrino
 {
     using hash_map<schema::neutrino>::hashmap;
 
+    /// Filter view into the mapped body, valid only while memory is retained.
+    /// Retained memory holds a shared lock on body remap, so the view must be
+    /// released prior to any store write that may require remap.
+    struct view
+    {
+        memory_ptr memory{};
+        hash_digest filter_head{};
+        system::data_slice filter{};
+    };
+
+    /// Get a view of the filter at element, without copying filter bytes.
+    inline bool get_view(view& out, const link& element) const NOEXCEPT
+    {
+        // Release any prior view before taking the memory lock again.
+        out.memory.reset();
+        auto memory = get_memory(element);
+        if (!memory)
+            return false;
+
+        reader source{ memory };
+        source.skip_bytes(schema::neutrino::pk + schema::neutrino::sk);
+        out.filter_head = source.read_hash();
+        const auto size = source.read_size();
+        const auto start = source.get_read_position();
+        source.skip_bytes(size);
+        if (!source)
+            return false;
+
+        const auto begin = std::next(memory->begin(), start);
+        out.filter = { begin, std::next(begin, size) };
+        out.memory = std::move(memory);
+        return true;
+    }
+
     struct slab
       : public schema::neutrino
     {
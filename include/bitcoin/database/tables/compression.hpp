@@ -0,0 +1,474 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_TABLES_COMPRESSION_HPP
+#define LIBBITCOIN_DATABASE_TABLES_COMPRESSION_HPP
+
+#include <algorithm>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/define.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+/// Compact serialization of common output script templates.
+/// Template codes occupy the upper one-byte varint values otherwise used for
+/// raw script sizes. A raw script of such size is escaped as a non-minimal
+/// (three byte) varint, so all other raw scripts are encoded as by script
+/// to_data(sink, true). Uncompressed p2pk is not compressed, as restoration
+/// would require point decompression for each read.
+/// Amounts may be compressed by trailing decimal zeros (as CompressAmount).
+/// A compressed amount is written as a non-minimal varint, which a raw amount
+/// never is, so amounts are decoded without reference to the writer option.
+struct compression
+{
+    /// Template codes (payload is key or hash bytes only).
+    static constexpr uint8_t pay_key_hash = 0xf6;
+    static constexpr uint8_t pay_script_hash = 0xf7;
+    static constexpr uint8_t pay_even_key = 0xf8;
+    static constexpr uint8_t pay_odd_key = 0xf9;
+    static constexpr uint8_t pay_witness_key_hash = 0xfa;
+    static constexpr uint8_t pay_witness_script_hash = 0xfb;
+    static constexpr uint8_t pay_taproot = 0xfc;
+
+    static constexpr bool is_template(size_t value) NOEXCEPT
+    {
+        return value >= pay_key_hash && value <= pay_taproot;
+    }
+
+    /// Serialized size of compressed script.
+    static inline size_t script_size(
+        const system::chain::script& script) NOEXCEPT
+    {
+        const auto size = script.serialized_size(false);
+        if (is_template_size(size))
+        {
+            const auto code = to_code(script.to_data(false));
+            if (is_template(code))
+                return sizeof(uint8_t) + payload_size(code);
+        }
+
+        return raw_prefix_size(size) + size;
+    }
+
+    static inline system::data_chunk script_to_data(
+        const system::chain::script& script) NOEXCEPT
+    {
+        system::data_chunk data(script_size(script));
+        system::write::bytes::copy sink{ data };
+        script_to_data(sink, script);
+        return data;
+    }
+
+    template <typename Sink>
+    static inline void script_to_data(Sink& sink,
+        const system::chain::script& script) NOEXCEPT
+    {
+        const auto size = script.serialized_size(false);
+        if (is_template_size(size))
+        {
+            const auto bytes = script.to_data(false);
+            const auto code = to_code(bytes);
+            if (is_template(code))
+            {
+                const auto start = payload_offset(code);
+                sink.write_byte(code);
+                sink.write_bytes(std::next(bytes.data(), start),
+                    payload_size(code));
+                return;
+            }
+        }
+
+        raw_prefix_to_data(sink, size);
+        script.to_data(sink, false);
+    }
+
+    /// Copy compressed script bytes from source, without decompression.
+    template <typename Source>
+    static inline system::data_chunk script_data(Source& source) NOEXCEPT
+    {
+        const auto code = source.peek_byte();
+        if (is_template(code))
+            return source.read_bytes(sizeof(uint8_t) + payload_size(code));
+
+        // The raw size prefix is minimal (or escaped), so is reproduced.
+        const auto size = source.read_size();
+        const auto prefix = raw_prefix_size(size);
+        system::data_chunk data(prefix + size);
+        system::write::bytes::copy sink{ data };
+        raw_prefix_to_data(sink, size);
+        source.read_bytes(std::next(data.data(), prefix), size);
+        return data;
+    }
+
+    template <typename Source>
+    static inline system::chain::script script_from_data(
+        Source& source) NOEXCEPT
+    {
+        using namespace system;
+        const auto code = source.peek_byte();
+        if (!is_template(code))
+            return chain::script{ source.read_bytes(source.read_size()),
+                false };
+
+        source.skip_byte();
+        const auto payload = source.read_bytes(payload_size(code));
+        data_chunk bytes{};
+        bytes.reserve(template_size(code));
+
+        switch (code)
+        {
+            case pay_key_hash:
+                bytes = { 0x76, 0xa9, 0x14 };
+                extend(bytes, payload);
+                extend(bytes, data_chunk{ 0x88, 0xac });
+                break;
+            case pay_script_hash:
+                bytes = { 0xa9, 0x14 };
+                extend(bytes, payload);
+                bytes.push_back(0x87);
+                break;
+            case pay_even_key:
+            case pay_odd_key:
+                bytes = { 0x21, code == pay_even_key ? 0x02_u8 : 0x03_u8 };
+                extend(bytes, payload);
+                bytes.push_back(0xac);
+                break;
+            case pay_witness_key_hash:
+                bytes = { 0x00, 0x14 };
+                extend(bytes, payload);
+                break;
+            case pay_witness_script_hash:
+                bytes = { 0x00, 0x20 };
+                extend(bytes, payload);
+                break;
+            case pay_taproot:
+            default:
+                bytes = { 0x51, 0x20 };
+                extend(bytes, payload);
+                break;
+        }
+
+        return chain::script{ bytes, false };
+    }
+
+    /// Copy bytes from source to sink through a bounded stack buffer.
+    template <typename Source, typename Sink>
+    static inline void copy_bytes(Source& source, Sink& sink,
+        size_t size) NOEXCEPT
+    {
+        std_array<uint8_t, 256> buffer{};
+        while (!is_zero(size) && source)
+        {
+            const auto count = std::min(size, buffer.size());
+            source.read_bytes(buffer.data(), count);
+            sink.write_bytes(buffer.data(), count);
+            size -= count;
+        }
+    }
+
+    /// Copy compressed script to sink as a size-prefixed (wire) script.
+    template <typename Source, typename Sink>
+    static inline void script_to_wire(Source& source, Sink& sink) NOEXCEPT
+    {
+        using namespace system;
+        const auto code = source.peek_byte();
+        if (!is_template(code))
+        {
+            const auto size = source.read_size();
+            sink.write_variable(size);
+            copy_bytes(source, sink, size);
+            return;
+        }
+
+        source.skip_byte();
+        sink.write_variable(template_size(code));
+        const auto payload = [&]() NOEXCEPT
+        {
+            copy_bytes(source, sink, payload_size(code));
+        };
+
+        switch (code)
+        {
+            case pay_key_hash:
+                sink.write_byte(0x76);
+                sink.write_byte(0xa9);
+                sink.write_byte(0x14);
+                payload();
+                sink.write_byte(0x88);
+                sink.write_byte(0xac);
+                break;
+            case pay_script_hash:
+                sink.write_byte(0xa9);
+                sink.write_byte(0x14);
+                payload();
+                sink.write_byte(0x87);
+                break;
+            case pay_even_key:
+            case pay_odd_key:
+                sink.write_byte(0x21);
+                sink.write_byte(code == pay_even_key ? 0x02_u8 : 0x03_u8);
+                payload();
+                sink.write_byte(0xac);
+                break;
+            case pay_witness_key_hash:
+                sink.write_byte(0x00);
+                sink.write_byte(0x14);
+                payload();
+                break;
+            case pay_witness_script_hash:
+                sink.write_byte(0x00);
+                sink.write_byte(0x20);
+                payload();
+                break;
+            case pay_taproot:
+            default:
+                sink.write_byte(0x51);
+                sink.write_byte(0x20);
+                payload();
+                break;
+        }
+    }
+
+    /// Amount compression (exploits trailing decimal zeros).
+    static constexpr uint64_t compress_amount(uint64_t value) NOEXCEPT
+    {
+        if (is_zero(value))
+            return zero;
+
+        uint64_t exponent{};
+        while (is_zero(value % 10u) && exponent < 9u)
+        {
+            value /= 10u;
+            ++exponent;
+        }
+
+        if (exponent < 9u)
+        {
+            const auto digit = value % 10u;
+            value /= 10u;
+            return add1((value * 9u + digit - 1u) * 10u + exponent);
+        }
+
+        return add1(sub1(value) * 10u + 9u);
+    }
+
+    static constexpr uint64_t decompress_amount(uint64_t value) NOEXCEPT
+    {
+        if (is_zero(value))
+            return zero;
+
+        value = sub1(value);
+        auto exponent = value % 10u;
+        value /= 10u;
+
+        uint64_t amount{};
+        if (exponent < 9u)
+        {
+            const auto digit = add1(value % 9u);
+            value /= 9u;
+            amount = value * 10u + digit;
+        }
+        else
+        {
+            amount = add1(value);
+        }
+
+        while (!is_zero(exponent--))
+            amount *= 10u;
+
+        return amount;
+    }
+
+    /// Serialized size of amount, compact only if smaller.
+    static constexpr size_t amount_size(uint64_t value, bool compact) NOEXCEPT
+    {
+        const auto raw = system::variable_size(value);
+        return compact ? std::min(raw, compact_size(value)) : raw;
+    }
+
+    template <typename Sink>
+    static inline void amount_to_data(Sink& sink, uint64_t value,
+        bool compact) NOEXCEPT
+    {
+        using namespace system;
+        if (!compact || compact_size(value) >= variable_size(value))
+        {
+            sink.write_variable(value);
+            return;
+        }
+
+        const auto amount = compress_amount(value);
+        switch (compact_size(value))
+        {
+            case 3u:
+                sink.write_byte(varint_two_bytes);
+                sink.write_2_bytes_little_endian(narrow_cast<uint16_t>(amount));
+                break;
+            case 5u:
+                sink.write_byte(varint_four_bytes);
+                sink.write_4_bytes_little_endian(narrow_cast<uint32_t>(amount));
+                break;
+            default:
+                sink.write_byte(varint_eight_bytes);
+                sink.write_8_bytes_little_endian(amount);
+                break;
+        }
+    }
+
+    /// Decodes both raw and compact amounts.
+    template <typename Source>
+    static inline uint64_t amount_from_data(Source& source) NOEXCEPT
+    {
+        using namespace system;
+        uint64_t value{};
+        const auto prefix = source.read_byte();
+        switch (prefix)
+        {
+            case varint_two_bytes:
+                value = source.read_2_bytes_little_endian();
+                return value < varint_two_bytes ?
+                    decompress_amount(value) : value;
+            case varint_four_bytes:
+                value = source.read_4_bytes_little_endian();
+                return value <= max_uint16 ? decompress_amount(value) : value;
+            case varint_eight_bytes:
+                value = source.read_8_bytes_little_endian();
+                return value <= max_uint32 ? decompress_amount(value) : value;
+            default:
+                return prefix;
+        }
+    }
+
+    /// Template code of the raw (unprefixed) script, or zero if none.
+    static inline uint8_t to_code(const system::data_chunk& bytes) NOEXCEPT
+    {
+        BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+        const auto is = [&](size_t index, uint8_t value) NOEXCEPT
+        {
+            return bytes.at(index) == value;
+        };
+
+        switch (bytes.size())
+        {
+            case 25:
+                return is(0, 0x76) && is(1, 0xa9) && is(2, 0x14) &&
+                    is(23, 0x88) && is(24, 0xac) ? pay_key_hash : 0;
+            case 23:
+                return is(0, 0xa9) && is(1, 0x14) && is(22, 0x87) ?
+                    pay_script_hash : 0;
+            case 35:
+                if (!is(0, 0x21) || !is(34, 0xac)) return 0;
+                return is(1, 0x02) ? pay_even_key :
+                    (is(1, 0x03) ? pay_odd_key : 0);
+            case 22:
+                return is(0, 0x00) && is(1, 0x14) ? pay_witness_key_hash : 0;
+            case 34:
+                if (!is(1, 0x20)) return 0;
+                return is(0, 0x00) ? pay_witness_script_hash :
+                    (is(0, 0x51) ? pay_taproot : 0);
+            default:
+                return 0;
+        }
+        BC_POP_WARNING()
+    }
+
+private:
+    // Size of non-minimal varint encoding of compressed amount.
+    static constexpr size_t compact_size(uint64_t value) NOEXCEPT
+    {
+        using namespace system;
+
+        // Larger values could overflow decompression (never smaller anyway).
+        if (value > max_uint64 / 10u)
+            return max_size_t;
+
+        const auto amount = compress_amount(value);
+        if (amount < varint_two_bytes)
+            return 3u;
+        if (amount <= max_uint16)
+            return 5u;
+        if (amount <= max_uint32)
+            return 9u;
+
+        return max_size_t;
+    }
+
+    static constexpr bool is_template_size(size_t size) NOEXCEPT
+    {
+        return size == 22 || size == 23 || size == 25 || size == 34 ||
+            size == 35;
+    }
+
+    static constexpr size_t raw_prefix_size(size_t size) NOEXCEPT
+    {
+        return is_template(size) ? 3 : system::variable_size(size);
+    }
+
+    template <typename Sink>
+    static inline void raw_prefix_to_data(Sink& sink, size_t size) NOEXCEPT
+    {
+        if (is_template(size))
+        {
+            // Escape raw size that collides with template code.
+            using namespace system;
+            sink.write_byte(varint_two_bytes);
+            sink.write_2_bytes_little_endian(narrow_cast<uint16_t>(size));
+        }
+        else
+        {
+            sink.write_variable(size);
+        }
+    }
+
+    static constexpr size_t payload_size(uint8_t code) NOEXCEPT
+    {
+        switch (code)
+        {
+            case pay_key_hash:
+            case pay_script_hash:
+            case pay_witness_key_hash:
+                return 20;
+            default:
+                return 32;
+        }
+    }
+
+    static constexpr size_t payload_offset(uint8_t code) NOEXCEPT
+    {
+        return code == pay_key_hash ? 3 : 2;
+    }
+
+    static constexpr size_t template_size(uint8_t code) NOEXCEPT
+    {
+        switch (code)
+        {
+            case pay_key_hash: return 25;
+            case pay_script_hash: return 23;
+            case pay_even_key:
+            case pay_odd_key: return 35;
+            case pay_witness_key_hash: return 22;
+            default: return 34;
+        }
+    }
+};
+
+} // namespace database
+} // namespace libbitcoin
+
+#endif
@@ -22,6 +22,7 @@
 #include <bitcoin/system.hpp>
 #include <bitcoin/database/define.hpp>
 #include <bitcoin/database/primitives/primitives.hpp>
+#include <bitcoin/database/tables/compression.hpp>
 #include <bitcoin/database/tables/schema.hpp>
 
 namespace libbitcoin {
@@ -29,34 +30,90 @@ namespace database {
 namespace table {
 
 /// address is a record multimap of output fk records.
+/// Keyed by a short id of the output script (siphash of its compressed form
+/// under a random per-store salt), so distinct scripts may share a key and
+/// must be resolved against the script. Hashing the compressed form allows
+/// the id to be computed from stored output bytes without parsing a script. The salt prevents a script crafted to collide with a known
+/// script's id. Each record carries the confirmed height of its output, or
+/// terminal if not confirmed when written (or since popped).
 struct address
   : public hash_map<schema::address>
 {
     using out = linkage<schema::put>;
+    using block = linkage<schema::block>;
     using hash_map<schema::address>::hashmap;
 
+    static inline key script_id(const system::data_slice& compressed,
+        const system::half_hash& salt) NOEXCEPT
+    {
+        auto value = system::siphash(salt, compressed);
+
+        key id{};
+        for (auto& byte: id)
+        {
+            byte = system::narrow_cast<uint8_t>(value);
+            value >>= byte_bits;
+        }
+
+        return id;
+    }
+
+    static inline key script_id(const system::chain::script& script,
+        const system::half_hash& salt) NOEXCEPT
+    {
+        return script_id(compression::script_to_data(script), salt);
+    }
+
+    inline key script_id(const system::data_slice& compressed) const NOEXCEPT
+    {
+        return script_id(compressed, salt_);
+    }
+
+    inline key script_id(const system::chain::script& script) const NOEXCEPT
+    {
+        return script_id(script, salt_);
+    }
+
+    /// Set by the store on create/open, prior to any keyed read or write.
+    inline void set_salt(const system::half_hash& salt) NOEXCEPT
+    {
+        salt_ = salt;
+    }
+
     struct record
       : public schema::address
     {
         inline bool from_data(reader& source) NOEXCEPT
         {
             output_fk = source.read_little_endian<out::integer, out::size>();
+            height = source.read_little_endian<block::integer, block::size>();
             return source;
         }
 
         inline bool to_data(finalizer& sink) const NOEXCEPT
         {
             sink.write_little_endian<out::integer, out::size>(output_fk);
+            sink.write_little_endian<block::integer, block::size>(height);
             return sink;
         }
 
         inline bool operator==(const record& other) const NOEXCEPT
         {
-            return output_fk == other.output_fk;
+            return output_fk == other.output_fk
+                && height == other.height;
+        }
+
+        inline bool is_confirmed() const NOEXCEPT
+        {
+            return height != block::terminal;
         }
 
         out::integer output_fk{};
+        block::integer height{ block::terminal };
     };
+
+private:
+    system::half_hash salt_{};
 };
 
 } // namespace table
@@ -35,6 +35,18 @@ struct height
     using block = linkage<schema::block>;
     using array_map<schema::height>::arraymap;
 
+    /// Zero-copy field access to a record in the mapped body.
+    struct view
+      : public array_view<schema::height>
+    {
+        using array_view<schema::height>::view;
+
+        inline block::integer header_fk() const NOEXCEPT
+        {
+            return read_little_endian<zero, block::integer, block::size>();
+        }
+    };
+
     struct record
       : public schema::height
     {
@@ -57,6 +69,27 @@ struct height
 
         block::integer header_fk{};
     };
+
+    /// Reads up to header_fks.size() contiguous records from the given link.
+    /// The mapped range ends at its segment, so header_fks may be truncated.
+    struct record_range
+      : public schema::height
+    {
+        inline bool from_data(reader& source) NOEXCEPT
+        {
+            // Clear the single record limit (segment limit remains).
+            source.set_limit();
+
+            auto fk = header_fks.begin();
+            for (; fk != header_fks.end() && !source.is_exhausted(); ++fk)
+                *fk = source.read_little_endian<block::integer, block::size>();
+
+            header_fks.erase(fk, header_fks.end());
+            return source;
+        }
+
+        std_vector<block::integer> header_fks{};
+    };
 };
 
 } // namespace table
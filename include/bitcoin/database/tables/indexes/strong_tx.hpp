@@ -35,6 +35,18 @@ struct strong_tx
     using block = linkage<schema::block>;
     using hash_map<schema::strong_tx>::hashmap;
 
+    /// Zero-copy field access to a record in the mapped body.
+    struct view
+      : public hash_view<schema::strong_tx>
+    {
+        using hash_view<schema::strong_tx>::view;
+
+        inline block::integer header_fk() const NOEXCEPT
+        {
+            return read_little_endian<zero, block::integer, block::size>();
+        }
+    };
+
     struct record
       : public schema::strong_tx
     {
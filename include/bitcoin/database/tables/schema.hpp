@@ -47,6 +47,7 @@ namespace schema
         constexpr auto point = "archive_point";
         constexpr auto input = "archive_input";
         constexpr auto output = "archive_output";
+        constexpr auto witness = "archive_witness";
         constexpr auto puts = "archive_puts";
         constexpr auto txs = "archive_txs";
         constexpr auto tx = "archive_tx";
@@ -57,6 +58,7 @@ namespace schema
         constexpr auto address = "address";
         constexpr auto candidate = "candidate";
         constexpr auto confirmed = "confirmed";
+        constexpr auto indexed = "indexed";
         constexpr auto strong_tx = "strong_tx";
     }
 
@@ -67,6 +69,7 @@ namespace schema
         constexpr auto neutrino = "neutrino";
         constexpr auto validated_bk = "validated_bk";
         constexpr auto validated_tx = "validated_tx";
+        constexpr auto balance = "balance";
     }
 
     namespace locks
@@ -75,6 +78,14 @@ namespace schema
         constexpr auto process = "process";
     }
 
+    namespace version
+    {
+        /// Store layout version, increment on any incompatible table change.
+        /// The file holds the version byte followed by the address id salt.
+        constexpr auto file = "version";
+        constexpr uint8_t value = 3;
+    }
+
     namespace ext
     {
         constexpr auto head = ".head";
@@ -105,7 +116,7 @@ namespace schema
     constexpr size_t flags = 4;     // fork flags.
 
     /// Primary keys.
-    constexpr size_t put = 5;       // ->input/output slab.
+    constexpr size_t put = 5;       // ->input/output/witness slab.
     constexpr size_t puts_ = 4;     // ->puts record.
     constexpr size_t txs_ = 4;      // ->txs slab.
     constexpr size_t tx = 4;        // ->tx record.
@@ -114,9 +125,11 @@ namespace schema
     constexpr size_t tx_slab = 4;   // ->validated_tk record (guestimate).
     constexpr size_t buffer_ = 5;   // ->buffer record (guestimate).
     constexpr size_t neutrino_ = 5; // ->neutrino record (guestimate).
+    constexpr size_t balance_ = 4;  // ->balance record.
 
     /// Search keys.
     constexpr size_t hash = system::hash_size;
+    constexpr size_t script_id = 8; // short output script identifier.
 
     /// Archive tables.
     /// -----------------------------------------------------------------------
@@ -211,6 +224,19 @@ namespace schema
         static_assert(minrow == 11u);
     };
 
+    // blob
+    struct witness
+    {
+        static constexpr size_t pk = schema::put;
+        static constexpr size_t sk = zero;
+        static constexpr size_t minsize =
+            1u;  // variable_size (average 1)
+        static constexpr size_t minrow = minsize;
+        static constexpr size_t size = max_size_t;
+        static_assert(minsize == 1u);
+        static_assert(minrow == 1u);
+    };
+
     // record hashmap
     struct point
     {
@@ -257,15 +283,15 @@ namespace schema
     struct address
     {
         static constexpr size_t pk = schema::puts_;
-        ////static constexpr size_t sk = schema::point::pk;
-        static constexpr size_t sk = schema::hash;
-        static constexpr size_t minsize = schema::put;
+        static constexpr size_t sk = schema::script_id;
+        static constexpr size_t minsize =
+            schema::put +
+            schema::block;
         static constexpr size_t minrow = pk + sk + minsize;
         static constexpr size_t size = minsize;
         static constexpr linkage<pk> count() NOEXCEPT { return 1; }
-        static_assert(minsize == 5u);
-        ////static_assert(minrow == 13u);
-        static_assert(minrow == 41u);
+        static_assert(minsize == 8u);
+        static_assert(minrow == 20u);
     };
 
     // record hashmap
@@ -355,6 +381,22 @@ namespace schema
         static_assert(minsize == 14u);
         static_assert(minrow == 22u);
     };
+
+    // record hashmap
+    struct balance
+    {
+        static constexpr size_t pk = schema::balance_;
+        static constexpr size_t sk = schema::script_id;
+        static constexpr size_t minsize =
+            schema::put +
+            sizeof(uint64_t) +
+            sizeof(uint32_t);
+        static constexpr size_t minrow = pk + sk + minsize;
+        static constexpr size_t size = minsize;
+        static constexpr linkage<pk> count() NOEXCEPT { return 1; }
+        static_assert(minsize == 17u);
+        static_assert(minrow == 29u);
+    };
 }
 
 } // namespace database
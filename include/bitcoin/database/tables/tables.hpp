@@ -26,7 +26,9 @@
 #include <bitcoin/database/tables/archives/puts.hpp>
 #include <bitcoin/database/tables/archives/transaction.hpp>
 #include <bitcoin/database/tables/archives/txs.hpp>
+#include <bitcoin/database/tables/archives/witness.hpp>
 
+#include <bitcoin/database/tables/caches/balance.hpp>
 #include <bitcoin/database/tables/caches/bootstrap.hpp>
 #include <bitcoin/database/tables/caches/buffer.hpp>
 #include <bitcoin/database/tables/caches/neutrino.hpp>
@@ -37,6 +39,7 @@
 #include <bitcoin/database/tables/indexes/height.hpp>
 #include <bitcoin/database/tables/indexes/strong_tx.hpp>
 
+#include <bitcoin/database/tables/compression.hpp>
 #include <bitcoin/database/tables/context.hpp>
 #include <bitcoin/database/tables/schema.hpp>
 
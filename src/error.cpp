@@ -68,6 +68,7 @@ DEFINE_ERROR_T_MESSAGE_MAP(error)
     { backup_table, "failed to backup table" },
     { restore_table, "failed to restore table" },
     { verify_table, "failed to verify table" },
+    { store_version, "store version mismatch" },
 
     // states
     { tx_connected, "transaction connected" },
@@ -20,6 +20,8 @@
 
 #if defined(HAVE_MSC)
     #include <io.h>
+#else
+    #include <unistd.h>
 #endif
 #include <fcntl.h>
 #include <sys/stat.h>
@@ -175,6 +177,57 @@ bool size(size_t& out, int file_descriptor) NOEXCEPT
     return true;
 }
 
+bool allocate(int file_descriptor, size_t size) NOEXCEPT
+{
+    if (file_descriptor == -1)
+        return false;
+
+    size_t current{};
+    if (!file::size(current, file_descriptor))
+        return false;
+
+    if (size <= current)
+        return true;
+
+    BC_PUSH_WARNING(NO_STATIC_CAST)
+#if defined(HAVE_MSC)
+    // Windows does not create sparse files by default (allocates on extend).
+    return is_zero(_chsize_s(file_descriptor, static_cast<int64_t>(size)));
+#elif defined(F_PREALLOCATE)
+    // macOS: allocate contiguous if possible, otherwise any, then extend.
+    fstore_t store{ F_ALLOCATECONTIG, F_PEOFPOSMODE, 0,
+        static_cast<off_t>(size - current), 0 };
+    if (::fcntl(file_descriptor, F_PREALLOCATE, &store) == -1)
+    {
+        store.fst_flags = F_ALLOCATEALL;
+        if (::fcntl(file_descriptor, F_PREALLOCATE, &store) == -1)
+            return false;
+    }
+
+    return ::ftruncate(file_descriptor, static_cast<off_t>(size)) != -1;
+#else
+    // posix_fallocate returns error number (not -1/errno).
+    return is_zero(::posix_fallocate(file_descriptor,
+        static_cast<off_t>(current), static_cast<off_t>(size - current)));
+#endif
+    BC_POP_WARNING()
+}
+
+bool reserve(int file_descriptor, size_t offset, size_t size) NOEXCEPT
+{
+    if (file_descriptor == -1)
+        return false;
+
+#if defined(FALLOC_FL_KEEP_SIZE)
+    BC_PUSH_WARNING(NO_STATIC_CAST)
+    return is_zero(size) || ::fallocate(file_descriptor, FALLOC_FL_KEEP_SIZE,
+        static_cast<off_t>(offset), static_cast<off_t>(size)) != -1;
+    BC_POP_WARNING()
+#else
+    return true;
+#endif
+}
+
 size_t page() NOEXCEPT
 {
 #if defined(HAVE_MSC)
@@ -26,6 +26,8 @@
     #include <sys/types.h>
 #endif
 #include <fcntl.h>
+#include <algorithm>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -43,10 +45,13 @@ BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
 
 using namespace system;
 
-map::map(const path& filename, size_t minimum, size_t expansion) NOEXCEPT
+map::map(const path& filename, size_t minimum, size_t expansion,
+    bool preallocate, bool ahead) NOEXCEPT
   : filename_(filename),
     minimum_(minimum),
     expansion_(expansion),
+    preallocate_(preallocate),
+    ahead_(preallocate && ahead),
     memory_map_(nullptr),
     loaded_(false),
     logical_(zero),
@@ -276,6 +281,32 @@ memory_ptr map::get(size_t offset) const NOEXCEPT
     return ptr;
 }
 
+void map::align(size_t) NOEXCEPT
+{
+}
+
+// Page faults issue one synchronous read each. Advising pages of a batch of
+// pending lookups in advance queues their reads with the device in parallel.
+void map::prefetch(size_t offset, size_t size) const NOEXCEPT
+{
+    std::shared_lock map_lock(map_mutex_);
+
+    if (!loaded_ || is_zero(size))
+        return;
+
+    // madvise requires a page-aligned address, and bounds are capacity.
+    static const auto page = file::page();
+    if (is_zero(page) || offset >= capacity_)
+        return;
+
+    const auto start = offset - (offset % page);
+    const auto end = std::min(ceilinged_add(offset, size), capacity_);
+
+    // Advisory, failure is not reported.
+    /* int */ ::madvise(std::next(memory_map_, start), end - start,
+        MADV_WILLNEED);
+}
+
 // private, mman wrappers, not thread safe
 // ----------------------------------------------------------------------------
 
@@ -309,6 +340,9 @@ bool map::flush_() const NOEXCEPT
 // Trims to logical size, can be zero.
 bool map::unmap_() NOEXCEPT
 {
+    // Background reservation may not outlive the mapping (or descriptor).
+    /* bool */ reserved_();
+
 #if defined(HAVE_MSC)
     const auto success =
            (::msync(memory_map_, logical_, MS_SYNC) != fail)
@@ -339,7 +373,7 @@ bool map::map_() NOEXCEPT
     if (size < minimum_)
     {
         size = minimum_;
-        if (::ftruncate(descriptor_, size) == fail)
+        if (!resize_(size))
             return false;
     }
 
@@ -362,7 +396,10 @@ bool map::remap_(size_t size) NOEXCEPT
         return false;
 #endif
 
-    if (::ftruncate(descriptor_, size) == fail)
+    // A failed background reservation is not fatal (it is advisory).
+    /* bool */ reserved_();
+
+    if (!resize_(size))
         return false;
 
 #if defined(HAVE_MSC)
@@ -394,9 +431,44 @@ bool map::finalize_(size_t size) NOEXCEPT
     }
 
     capacity_ = size;
+    reserve_();
     return true;
 }
 
+// Grow file to size, allocating blocks if preallocate (sparse otherwise).
+bool map::resize_(size_t size) NOEXCEPT
+{
+    if (preallocate_)
+        return file::allocate(descriptor_, size);
+
+    return ::ftruncate(descriptor_, size) != fail;
+}
+
+// Reserve blocks for the next growth step beyond capacity, off this thread.
+// Blocks allocated beyond file size are retained through subsequent growth.
+void map::reserve_() NOEXCEPT
+{
+    if (!ahead_)
+        return;
+
+    const auto start = capacity_;
+    const auto count = floored_subtract(to_capacity(add1(start)), start);
+    reservation_ = std::async(std::launch::async,
+        [descriptor = descriptor_, start, count]() NOEXCEPT
+        {
+            return file::reserve(descriptor, start, count);
+        });
+}
+
+// Wait on any pending reservation, false if it failed.
+bool map::reserved_() NOEXCEPT
+{
+    if (!reservation_.valid())
+        return true;
+
+    return reservation_.get();
+}
+
 BC_POP_WARNING()
 
 } // namespace database
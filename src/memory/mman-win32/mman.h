@@ -37,6 +37,7 @@ extern "C" {
 
 /* Flags for madvise (stub). */
 #define MADV_RANDOM     0
+#define MADV_WILLNEED   3
 
 void* mmap(void* addr, size_t len, int prot, int flags, int fd, oft__ off);
 void* mremap_(void* addr, size_t old_size, size_t new_size, int prot,
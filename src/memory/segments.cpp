@@ -0,0 +1,441 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <bitcoin/database/memory/segments.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <bitcoin/system.hpp>
+#include <bitcoin/database/boost.hpp>
+#include <bitcoin/database/define.hpp>
+#include <bitcoin/database/error.hpp>
+#include <bitcoin/database/file/file.hpp>
+
+namespace libbitcoin {
+namespace database {
+
+BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+using namespace system;
+
+namespace {
+
+// Access to the full address space, holds a remap guard on each segment.
+// Only offset() spans segments, begin/end/size are of the first segment.
+class spanner
+  : public memory
+{
+public:
+    spanner(std_vector<memory_ptr>&& parts, size_t segment) NOEXCEPT
+      : parts_(std::move(parts)), segment_(segment)
+    {
+    }
+
+    uint8_t* offset(size_t value) NOEXCEPT override
+    {
+        const auto index = value / segment_;
+        if (index >= parts_.size() || !parts_.at(index))
+            return nullptr;
+
+        return parts_.at(index)->offset(value - index * segment_);
+    }
+
+    ptrdiff_t size() const NOEXCEPT override
+    {
+        return parts_.front()->size();
+    }
+
+    uint8_t* begin() NOEXCEPT override
+    {
+        return parts_.front()->begin();
+    }
+
+    uint8_t* end() NOEXCEPT override
+    {
+        return parts_.front()->end();
+    }
+
+private:
+    const std_vector<memory_ptr> parts_;
+    const size_t segment_;
+};
+
+} // namespace
+
+segments::segments(const path& filename, size_t minimum, size_t expansion,
+    bool preallocate, bool ahead, size_t segment) NOEXCEPT
+  : filename_(filename),
+    minimum_(minimum),
+    expansion_(expansion),
+    preallocate_(preallocate),
+    ahead_(ahead),
+    segment_(std::max(one, segment)),
+    maps_{},
+    active_(zero),
+    loaded_(false)
+{
+}
+
+segments::~segments() NOEXCEPT
+{
+    // LOG STOP WARNINGS (handled if unload() and close() were called).
+    BC_ASSERT_MSG(!loaded_, "segments mapped at destruct");
+    BC_ASSERT_MSG(maps_.empty(), "segments open at destruct");
+}
+
+size_t segments::segment() const NOEXCEPT
+{
+    return segment_;
+}
+
+size_t segments::count() const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    return active_;
+}
+
+const std::filesystem::path& segments::file() const NOEXCEPT
+{
+    return filename_;
+}
+
+std::filesystem::path segments::to_file(size_t index) const NOEXCEPT
+{
+    if (is_zero(index))
+        return filename_;
+
+    auto name = filename_;
+    return name.concat("." + std::to_string(index));
+}
+
+// Open, load, flush, unload, close.
+// ----------------------------------------------------------------------------
+
+code segments::open() NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (!maps_.empty())
+        return error::open_open;
+
+    // Open the first segment and each existing contiguous successor.
+    for (auto index = zero; is_zero(index) || file::is_file(to_file(index));
+        ++index)
+    {
+        auto segment = std::make_unique<map>(to_file(index), minimum_,
+            expansion_, preallocate_, ahead_);
+
+        if (const auto ec = segment->open())
+        {
+            for (auto& opened: maps_)
+                /* code */ opened->close();
+
+            maps_.clear();
+            return ec;
+        }
+
+        maps_.push_back(std::move(segment));
+    }
+
+    // Logical size ends in the first segment that is not full. Successors
+    // of that segment are empty (truncated) and reused upon growth.
+    active_ = maps_.size();
+    for (auto index = zero; index < maps_.size(); ++index)
+    {
+        if (maps_.at(index)->size() < segment_)
+        {
+            active_ = add1(index);
+            break;
+        }
+    }
+
+    return error::success;
+}
+
+code segments::close() NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (loaded_)
+        return error::close_loaded;
+
+    code ec{ error::success };
+    for (auto& segment: maps_)
+    {
+        const auto result = segment->close();
+        if (!ec) ec = result;
+    }
+
+    maps_.clear();
+    active_ = zero;
+    return ec;
+}
+
+code segments::load() NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (loaded_)
+        return error::load_loaded;
+
+    if (maps_.empty())
+        return error::load_failure;
+
+    for (auto index = zero; index < maps_.size(); ++index)
+    {
+        if (const auto ec = maps_.at(index)->load())
+        {
+            for (auto loaded = zero; loaded < index; ++loaded)
+                /* code */ maps_.at(loaded)->unload();
+
+            return ec;
+        }
+    }
+
+    loaded_ = true;
+    return error::success;
+}
+
+// Suspend writes before calling (unguarded here).
+code segments::flush() const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+
+    if (!loaded_)
+        return error::flush_unloaded;
+
+    // Each segment is flushed (fsync) in full, at the cost of a sync per file.
+    code ec{ error::success };
+    for (const auto& segment: maps_)
+    {
+        const auto result = segment->flush();
+        if (!ec) ec = result;
+    }
+
+    return ec;
+}
+
+code segments::unload() NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (!loaded_)
+        return error::success;
+
+    code ec{ error::success };
+    for (auto& segment: maps_)
+    {
+        const auto result = segment->unload();
+        if (!ec) ec = result;
+    }
+
+    // Restartable, unloaded segments are idempotent on retry.
+    if (ec)
+        return ec;
+
+    loaded_ = false;
+    return ec;
+}
+
+// Interface.
+// ----------------------------------------------------------------------------
+
+size_t segments::capacity() const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+
+    if (!loaded_ || is_zero(active_))
+        return zero;
+
+    const auto last = sub1(active_);
+    return last * segment_ + maps_.at(last)->capacity();
+}
+
+size_t segments::size() const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+    return size_();
+}
+
+bool segments::truncate(size_t size) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+
+    if (maps_.empty())
+        return is_zero(size);
+
+    if (size > size_())
+        return false;
+
+    // An exact multiple of segment size ends in (fills) the prior segment.
+    auto index = size / segment_;
+    auto local = size % segment_;
+    if (index == active_)
+    {
+        index = sub1(index);
+        local = segment_;
+    }
+
+    for (auto empty = add1(index); empty < active_; ++empty)
+        if (!maps_.at(empty)->truncate(zero))
+            return false;
+
+    active_ = add1(index);
+    return maps_.at(index)->truncate(local);
+}
+
+size_t segments::allocate(size_t chunk) NOEXCEPT
+{
+    // Upgrade lock allows concurrent get() during segment map allocation.
+    mutex_.lock_upgrade();
+
+    // log: allocate_unloaded, allocate_overflow
+    if (!loaded_ || is_zero(active_) || chunk > segment_)
+    {
+        mutex_.unlock_upgrade();
+        return storage::eof;
+    }
+
+    auto last = sub1(active_);
+    auto& current = *maps_.at(last);
+    const auto used = current.size();
+
+    if (chunk <= segment_ - used)
+    {
+        const auto position = current.allocate(chunk);
+        mutex_.unlock_upgrade();
+        return position == storage::eof ? position : last * segment_ + position;
+    }
+
+    // Pad the last segment to full and move to its successor.
+    if (used < segment_ && current.allocate(segment_ - used) == storage::eof)
+    {
+        mutex_.unlock_upgrade();
+        return storage::eof;
+    }
+
+    mutex_.unlock_upgrade_and_lock();
+
+    // log: segment_failure
+    if (active_ == maps_.size() && !add_())
+    {
+        mutex_.unlock();
+        return storage::eof;
+    }
+
+    last = active_++;
+    const auto position = maps_.at(last)->allocate(chunk);
+    mutex_.unlock();
+    return position == storage::eof ? position : last * segment_ + position;
+}
+
+void segments::align(size_t unit) NOEXCEPT
+{
+    std::unique_lock lock(mutex_);
+    BC_ASSERT_MSG(maps_.empty(), "segments open at align");
+
+    if (!is_zero(unit))
+        segment_ = std::max(unit, segment_ - (segment_ % unit));
+}
+
+memory_ptr segments::get(size_t offset) const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+
+    if (!loaded_ || is_zero(active_))
+        return nullptr;
+
+    // Full address space (only the iterator reads links across segments).
+    if (is_zero(offset) && !is_one(active_))
+    {
+        std_vector<memory_ptr> parts{};
+        parts.reserve(active_);
+        for (auto index = zero; index < active_; ++index)
+            parts.push_back(maps_.at(index)->get());
+
+        return std::make_shared<spanner>(std::move(parts), segment_);
+    }
+
+    // With offset > size the assignment is negative (stream is exhausted).
+    const auto index = std::min(offset / segment_, sub1(active_));
+    return maps_.at(index)->get(offset - index * segment_);
+}
+
+void segments::prefetch(size_t offset, size_t size) const NOEXCEPT
+{
+    std::shared_lock lock(mutex_);
+
+    if (!loaded_)
+        return;
+
+    const auto end = ceilinged_add(offset, size);
+    while (offset < end)
+    {
+        const auto index = offset / segment_;
+        if (index >= active_)
+            return;
+
+        const auto local = offset - index * segment_;
+        const auto bytes = std::min(end - offset, segment_ - local);
+        maps_.at(index)->prefetch(local, bytes);
+        offset += bytes;
+    }
+}
+
+// private, not thread safe
+// ----------------------------------------------------------------------------
+
+size_t segments::size_() const NOEXCEPT
+{
+    if (is_zero(active_))
+        return zero;
+
+    const auto last = sub1(active_);
+    return last * segment_ + maps_.at(last)->size();
+}
+
+// Create, open and load a new segment file.
+bool segments::add_() NOEXCEPT
+{
+    const auto name = to_file(maps_.size());
+    if (!file::is_file(name) && !file::create_file(name))
+        return false;
+
+    auto segment = std::make_unique<map>(name, minimum_, expansion_,
+        preallocate_, ahead_);
+
+    if (segment->open())
+        return false;
+
+    if (segment->load())
+    {
+        /* code */ segment->close();
+        return false;
+    }
+
+    maps_.push_back(std::move(segment));
+    return true;
+}
+
+BC_POP_WARNING()
+
+} // namespace database
+} // namespace libbitcoin
@@ -28,6 +28,11 @@ using namespace bc::system;
 
 settings::settings() NOEXCEPT
   : path{ "bitcoin" },
+    preallocate{ false },
+    preallocate_ahead{ false },
+    compact_amounts{ false },
+    separate_witness{ false },
+    compact_txs{ false },
 
     // Archives.
 
@@ -46,6 +51,9 @@ settings::settings() NOEXCEPT
     output_size{ 1 },
     output_rate{ 50 },
 
+    witness_size{ 1 },
+    witness_rate{ 50 },
+
     puts_size{ 1 },
     puts_rate{ 50 },
 
@@ -69,6 +77,9 @@ settings::settings() NOEXCEPT
     confirmed_size{ 1 },
     confirmed_rate{ 50 },
 
+    indexed_size{ 1 },
+    indexed_rate{ 50 },
+
     strong_tx_buckets{ 100 },
     strong_tx_size{ 1 },
     strong_tx_rate{ 50 },
@@ -92,7 +103,11 @@ settings::settings() NOEXCEPT
 
     validated_tx_buckets{ 100 },
     validated_tx_size{ 1 },
-    validated_tx_rate{ 50 }
+    validated_tx_rate{ 50 },
+
+    balance_buckets{ 100 },
+    balance_size{ 1 },
+    balance_rate{ 50 }
 {
 }
 
@@ -320,6 +320,15 @@ BOOST_AUTO_TEST_CASE(error_t__code__verify_table__true_exected_message)
     BOOST_REQUIRE_EQUAL(ec.message(), "failed to verify table");
 }
 
+BOOST_AUTO_TEST_CASE(error_t__code__store_version__true_exected_message)
+{
+    constexpr auto value = error::store_version;
+    const auto ec = code(value);
+    BOOST_REQUIRE(ec);
+    BOOST_REQUIRE(ec == value);
+    BOOST_REQUIRE_EQUAL(ec.message(), "store version mismatch");
+}
+
 BOOST_AUTO_TEST_CASE(error_t__code__tx_connected__true_exected_message)
 {
     constexpr auto value = error::tx_connected;
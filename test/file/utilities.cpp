@@ -272,6 +272,56 @@ BOOST_AUTO_TEST_CASE(utilities__size2__non_empty__true_expected)
     BOOST_REQUIRE_EQUAL(out, text.length());
 }
 
+BOOST_AUTO_TEST_CASE(utilities__allocate__invalid_handle__false)
+{
+    BOOST_REQUIRE(!file::allocate(-1, 42));
+}
+
+BOOST_AUTO_TEST_CASE(utilities__allocate__empty__true_expected)
+{
+    BOOST_REQUIRE(test::create(TEST_PATH));
+    const auto descriptor = file::open(TEST_PATH);
+    BOOST_REQUIRE_NE(descriptor, file::invalid);
+    BOOST_REQUIRE(file::allocate(descriptor, 42));
+
+    size_t out{};
+    BOOST_REQUIRE(file::size(out, descriptor));
+    BOOST_REQUIRE_EQUAL(out, 42u);
+    BOOST_REQUIRE(file::close(descriptor));
+}
+
+BOOST_AUTO_TEST_CASE(utilities__allocate__smaller__true_unchanged)
+{
+    const std::string text = "panopticon";
+    BOOST_REQUIRE(test::create(TEST_PATH, text));
+    const auto descriptor = file::open(TEST_PATH);
+    BOOST_REQUIRE_NE(descriptor, file::invalid);
+    BOOST_REQUIRE(file::allocate(descriptor, 1));
+
+    size_t out{};
+    BOOST_REQUIRE(file::size(out, descriptor));
+    BOOST_REQUIRE_EQUAL(out, text.length());
+    BOOST_REQUIRE(file::close(descriptor));
+}
+
+BOOST_AUTO_TEST_CASE(utilities__reserve__invalid_handle__false)
+{
+    BOOST_REQUIRE(!file::reserve(-1, 0, 42));
+}
+
+BOOST_AUTO_TEST_CASE(utilities__reserve__empty__true_unchanged)
+{
+    BOOST_REQUIRE(test::create(TEST_PATH));
+    const auto descriptor = file::open(TEST_PATH);
+    BOOST_REQUIRE_NE(descriptor, file::invalid);
+    BOOST_REQUIRE(file::reserve(descriptor, 0, 42));
+
+    size_t out{ 42 };
+    BOOST_REQUIRE(file::size(out, descriptor));
+    BOOST_REQUIRE_EQUAL(out, zero);
+    BOOST_REQUIRE(file::close(descriptor));
+}
+
 BOOST_AUTO_TEST_CASE(utilities__page__always__non_zero)
 {
     BOOST_REQUIRE_NE(file::page(), zero);
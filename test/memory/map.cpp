@@ -336,6 +336,38 @@ BOOST_AUTO_TEST_CASE(map__allocate__no_minimum_expansion__expected_capacity)
     BOOST_REQUIRE_EQUAL(instance.close(), error::success);
 }
 
+BOOST_AUTO_TEST_CASE(map__allocate__preallocate__expected_capacity)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 50, true);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(100), zero);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 150u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 100u);
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(test::size(file), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(map__allocate__preallocate_ahead__expected_capacity)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file, 1, 50, true, true);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(100), zero);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 150u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(100), 100u);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), 300u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 200u);
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(test::size(file), 200u);
+}
+
 BOOST_AUTO_TEST_CASE(map__get__unloaded__false)
 {
     const std::string file = TEST_PATH;
@@ -358,6 +390,33 @@ BOOST_AUTO_TEST_CASE(map__get__loaded__success)
     BOOST_REQUIRE_EQUAL(instance.close(), error::success);
 }
 
+BOOST_AUTO_TEST_CASE(map__prefetch__unloaded__no_effect)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    instance.prefetch(0, 42);
+    BOOST_REQUIRE_EQUAL(instance.capacity(), zero);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(map__prefetch__loaded_out_of_bounds__unchanged)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    map instance(file);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(42), zero);
+    instance.prefetch(1, 41);
+    instance.prefetch(40, max_size_t);
+    instance.prefetch(max_size_t, 1);
+    BOOST_REQUIRE_EQUAL(instance.size(), 42u);
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
 BOOST_AUTO_TEST_CASE(map__flush__unloaded__false)
 {
     const std::string file = TEST_PATH;
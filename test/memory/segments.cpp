@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+
+struct segments_setup_fixture
+{
+    DELETE_COPY_MOVE(segments_setup_fixture);
+    BC_PUSH_WARNING(NO_THROW_IN_NOEXCEPT)
+
+    segments_setup_fixture() NOEXCEPT
+    {
+        BOOST_REQUIRE(test::clear(test::directory));
+    }
+
+    ~segments_setup_fixture() NOEXCEPT
+    {
+        BOOST_REQUIRE(test::clear(test::directory));
+    }
+
+    BC_POP_WARNING()
+};
+
+BOOST_FIXTURE_TEST_SUITE(segments_tests, segments_setup_fixture)
+
+class access
+  : public segments
+{
+public:
+    using segments::segments;
+    using segments::to_file;
+};
+
+BOOST_AUTO_TEST_CASE(segments__file__always__expected)
+{
+    const std::string file = TEST_PATH;
+    segments instance(file);
+    BOOST_REQUIRE_EQUAL(instance.file(), file);
+    BOOST_REQUIRE_EQUAL(instance.segment(), segments::default_segment);
+}
+
+BOOST_AUTO_TEST_CASE(segments__to_file__always__expected)
+{
+    const std::string file = TEST_PATH;
+    access instance(file);
+    BOOST_REQUIRE_EQUAL(instance.to_file(0), file);
+    BOOST_REQUIRE_EQUAL(instance.to_file(1), file + ".1");
+    BOOST_REQUIRE_EQUAL(instance.to_file(42), file + ".42");
+}
+
+BOOST_AUTO_TEST_CASE(segments__open__no_file__open_failure)
+{
+    const std::string file = TEST_PATH;
+    segments instance(file);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::open_failure);
+    BOOST_REQUIRE_EQUAL(instance.count(), zero);
+}
+
+BOOST_AUTO_TEST_CASE(segments__open__opened__open_open)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::open_open);
+    BOOST_REQUIRE_EQUAL(instance.count(), one);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(segments__close__loaded__close_loaded)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::close_loaded);
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(segments__allocate__unloaded__eof)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file, 1, 0, false, false, 10);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), storage::eof);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(segments__allocate__exceeds_segment__eof)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file, 1, 0, false, false, 10);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(11), storage::eof);
+    BOOST_REQUIRE_EQUAL(instance.size(), zero);
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(segments__allocate__spanning__padded_to_next_segment)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    access instance(file, 1, 0, false, false, 10);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(6), zero);
+    BOOST_REQUIRE_EQUAL(instance.allocate(4), 6u);
+    BOOST_REQUIRE_EQUAL(instance.count(), one);
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), 10u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(9), 11u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(3), 20u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(8), 30u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 4u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 38u);
+    BOOST_REQUIRE(test::exists(instance.to_file(3)));
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(test::size(instance.to_file(0)), 10u);
+    BOOST_REQUIRE_EQUAL(test::size(instance.to_file(2)), 10u);
+    BOOST_REQUIRE_EQUAL(test::size(instance.to_file(3)), 8u);
+}
+
+BOOST_AUTO_TEST_CASE(segments__open__existing_segments__expected_size)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file, 1, 0, false, false, 10);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(10), zero);
+    BOOST_REQUIRE_EQUAL(instance.allocate(7), 10u);
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 17u);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(segments__truncate__across_segments__expected)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file, 1, 0, false, false, 10);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(10), zero);
+    BOOST_REQUIRE_EQUAL(instance.allocate(10), 10u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(5), 20u);
+    BOOST_REQUIRE(!instance.truncate(26));
+    BOOST_REQUIRE(instance.truncate(20));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.size(), 20u);
+    BOOST_REQUIRE(instance.truncate(7));
+    BOOST_REQUIRE_EQUAL(instance.count(), one);
+    BOOST_REQUIRE_EQUAL(instance.size(), 7u);
+
+    // Emptied successor segment is reused.
+    BOOST_REQUIRE_EQUAL(instance.allocate(4), 10u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+    BOOST_REQUIRE(instance.truncate(7));
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+
+    // Empty successors are not counted upon reopen.
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.count(), one);
+    BOOST_REQUIRE_EQUAL(instance.size(), 7u);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(segments__get__across_segments__expected)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file, 1, 0, false, false, 10);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(10), zero);
+    BOOST_REQUIRE_EQUAL(instance.allocate(10), 10u);
+
+    auto memory = instance.get(12);
+    BOOST_REQUIRE(memory);
+    BOOST_REQUIRE_EQUAL(memory->size(), 8);
+    *memory->begin() = 0x42;
+    memory.reset();
+
+    memory = instance.get();
+    BOOST_REQUIRE(memory);
+    BOOST_REQUIRE_EQUAL(memory->size(), 10);
+    BOOST_REQUIRE_EQUAL(*memory->offset(12), 0x42);
+    BOOST_REQUIRE(is_null(memory->offset(20)));
+    memory.reset();
+
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(segments__flush__loaded__success)
+{
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+    segments instance(file, 1, 0, false, false, 10);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.flush(), error::flush_unloaded);
+    BOOST_REQUIRE_EQUAL(instance.load(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.allocate(10), zero);
+    BOOST_REQUIRE_EQUAL(instance.allocate(10), 10u);
+    BOOST_REQUIRE_EQUAL(instance.flush(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
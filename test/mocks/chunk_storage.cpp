@@ -39,7 +39,7 @@ chunk_storage::chunk_storage(system::data_chunk& reference) NOEXCEPT
 }
 
 chunk_storage::chunk_storage(const std::filesystem::path& filename,
-    size_t, size_t) NOEXCEPT
+    size_t, size_t, bool, bool) NOEXCEPT
   : path_{ filename }, local_{}, buffer_{ local_ }
 {
 }
@@ -128,6 +128,14 @@ memory_ptr chunk_storage::get(size_t offset) const NOEXCEPT
     return ptr;
 }
 
+void chunk_storage::prefetch(size_t, size_t) const NOEXCEPT
+{
+}
+
+void chunk_storage::align(size_t) NOEXCEPT
+{
+}
+
 BC_POP_WARNING()
 
 } // namespace test
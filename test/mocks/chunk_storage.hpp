@@ -32,7 +32,7 @@ public:
     chunk_storage() NOEXCEPT;
     chunk_storage(system::data_chunk& reference) NOEXCEPT;
     chunk_storage(const std::filesystem::path& filename, size_t minimum=1,
-        size_t expansion=0) NOEXCEPT;
+        size_t expansion=0, bool preallocate=false, bool ahead=false) NOEXCEPT;
 
     // test side door.
     system::data_chunk& buffer() NOEXCEPT;
@@ -49,6 +49,8 @@ public:
     bool truncate(size_t size) NOEXCEPT override;
     size_t allocate(size_t chunk) NOEXCEPT override;
     memory_ptr get(size_t offset=zero) const NOEXCEPT override;
+    void prefetch(size_t offset, size_t size) const NOEXCEPT override;
+    void align(size_t unit) NOEXCEPT override;
 
 private:
     system::data_chunk local_;
@@ -74,6 +74,16 @@ public:
         return output_body_.buffer();
     }
 
+    system::data_chunk& witness_head() NOEXCEPT
+    {
+        return witness_head_.buffer();
+    }
+
+    system::data_chunk& witness_body() NOEXCEPT
+    {
+        return witness_body_.buffer();
+    }
+
     system::data_chunk& puts_head() NOEXCEPT
     {
         return puts_head_.buffer();
@@ -136,6 +146,16 @@ public:
         return confirmed_body_.buffer();
     }
 
+    system::data_chunk& indexed_head() NOEXCEPT
+    {
+        return indexed_head_.buffer();
+    }
+
+    system::data_chunk& indexed_body() NOEXCEPT
+    {
+        return indexed_body_.buffer();
+    }
+
     system::data_chunk& strong_tx_head() NOEXCEPT
     {
         return strong_tx_head_.buffer();
@@ -197,6 +217,16 @@ public:
     {
         return validated_tx_body_.buffer();
     }
+
+    system::data_chunk& balance_head() NOEXCEPT
+    {
+        return balance_head_.buffer();
+    }
+
+    system::data_chunk& balance_body() NOEXCEPT
+    {
+        return balance_body_.buffer();
+    }
 };
 
 using query_accessor = query<store<chunk_storage>>;
@@ -95,6 +95,16 @@ public:
         return output_body_.file();
     }
 
+    inline const path& witness_head_file() const NOEXCEPT
+    {
+        return witness_head_.file();
+    }
+
+    inline const path& witness_body_file() const NOEXCEPT
+    {
+        return witness_body_.file();
+    }
+
     inline const path& puts_head_file() const NOEXCEPT
     {
         return puts_head_.file();
@@ -157,6 +167,16 @@ public:
         return confirmed_body_.file();
     }
 
+    inline const path& indexed_head_file() const NOEXCEPT
+    {
+        return indexed_head_.file();
+    }
+
+    inline const path& indexed_body_file() const NOEXCEPT
+    {
+        return indexed_body_.file();
+    }
+
     inline const path& strong_tx_head_file() const NOEXCEPT
     {
         return strong_tx_head_.file();
@@ -219,6 +239,16 @@ public:
         return validated_tx_body_.file();
     }
 
+    inline const path& balance_head_file() const NOEXCEPT
+    {
+        return balance_head_.file();
+    }
+
+    inline const path& balance_body_file() const NOEXCEPT
+    {
+        return balance_body_.file();
+    }
+
     // Locks.
 
     inline const path& flush_lock_file() const NOEXCEPT
@@ -0,0 +1,75 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBBITCOIN_DATABASE_TEST_MOCKS_SEGMENT_STORE_HPP
+#define LIBBITCOIN_DATABASE_TEST_MOCKS_SEGMENT_STORE_HPP
+
+#include "../test.hpp"
+
+namespace test {
+
+// Segments small enough that test bodies span several (heads fit in one).
+class small_segments
+  : public segments
+{
+public:
+    static constexpr size_t segment_size = 512;
+
+    small_segments(const std::filesystem::path& filename, size_t minimum=1,
+        size_t expansion=0, bool preallocate=false, bool ahead=false) NOEXCEPT
+      : segments(filename, minimum, expansion, preallocate, ahead,
+          segment_size)
+    {
+    }
+};
+
+// store<segments> test accessor.
+class segment_store
+  : public store<small_segments>
+{
+public:
+    using store<small_segments>::store;
+
+    // Segments spanned by bodies.
+
+    inline size_t header_segments() const NOEXCEPT
+    {
+        return header_body_.count();
+    }
+
+    inline size_t input_segments() const NOEXCEPT
+    {
+        return input_body_.count();
+    }
+
+    inline size_t output_segments() const NOEXCEPT
+    {
+        return output_body_.count();
+    }
+
+    inline size_t tx_segments() const NOEXCEPT
+    {
+        return tx_body_.count();
+    }
+};
+
+using segment_query = query<store<small_segments>>;
+
+} // namespace test
+
+#endif
@@ -327,6 +327,22 @@ BOOST_AUTO_TEST_CASE(arraymap__record_count__truncate__expected)
     BOOST_REQUIRE(body_file.empty());
 }
 
+BOOST_AUTO_TEST_CASE(arraymap__record_allocate_set__out_of_order__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    arraymap<link5, big_record::size> instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(instance.allocate(2), 0u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 2u);
+    BOOST_REQUIRE(instance.set(1, big_record{ 0x01020304_u32 }));
+    BOOST_REQUIRE(instance.set(0, big_record{ 0xa1b2c3d4_u32 }));
+
+    const data_chunk expected_file{ 0xa1, 0xb2, 0xc3, 0xd4, 0x01, 0x02, 0x03, 0x04 };
+    BOOST_REQUIRE_EQUAL(body_file, expected_file);
+}
+
 BOOST_AUTO_TEST_CASE(arraymap__record_put_link__multiple__expected)
 {
     data_chunk head_file;
@@ -398,6 +414,56 @@ public:
     uint32_t value{ 0 };
 };
 
+// Writes more bytes than its count.
+class overrun_slab
+{
+public:
+    static constexpr size_t size = max_size_t;
+    static constexpr link5 count() NOEXCEPT { return sizeof(uint16_t); }
+
+    bool to_data(database::writer& sink) const NOEXCEPT
+    {
+        sink.write_big_endian(value);
+        return sink;
+    }
+
+    uint32_t value{ 0 };
+};
+
+BOOST_AUTO_TEST_CASE(arraymap__slab_allocate_set__contiguous__expected)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    arraymap<link5, big_slab::size> instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(instance.allocate(2 * big_slab::count()), 0u);
+    BOOST_REQUIRE(instance.set(big_slab::count(), big_slab{ 0x01020304_u32 }));
+    BOOST_REQUIRE(instance.set(0, big_slab{ 0xa1b2c3d4_u32 }));
+
+    const data_chunk expected_file{ 0xa1, 0xb2, 0xc3, 0xd4, 0x01, 0x02, 0x03, 0x04 };
+    BOOST_REQUIRE_EQUAL(body_file, expected_file);
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__slab_allocate_set__overrun__false_next_unchanged)
+{
+    data_chunk head_file;
+    data_chunk body_file;
+    test::chunk_storage head_store{ head_file };
+    test::chunk_storage body_store{ body_file };
+    arraymap<link5, big_slab::size> instance{ head_store, body_store };
+    constexpr auto next = overrun_slab::count();
+    BOOST_REQUIRE_EQUAL(instance.allocate(next + big_slab::count()), 0u);
+    BOOST_REQUIRE(instance.set(next, big_slab{ 0x01020304_u32 }));
+
+    // The write is limited to the count, so the next slab is not overwritten.
+    BOOST_REQUIRE(!instance.set(0, overrun_slab{ 0xa1b2c3d4_u32 }));
+
+    big_slab slab{};
+    BOOST_REQUIRE(instance.get(next, slab));
+    BOOST_REQUIRE_EQUAL(slab.value, 0x01020304_u32);
+}
+
 BOOST_AUTO_TEST_CASE(arraymap__slab_put__get__expected)
 {
     data_chunk head_file;
@@ -830,4 +896,157 @@ BOOST_AUTO_TEST_CASE(arraymap__slab_body_count__non_empty_restore__truncates)
     BOOST_REQUIRE_EQUAL(body_file, base16_chunk("123456"));
 }
 
+// segmented body
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(arraymap__record_put__segmented_body__expected)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    // Ten byte segments are aligned to two (four byte) records.
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 10 };
+    arraymap<link5, big_record::size> instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(body_store.segment(), 8u);
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    for (uint32_t index = 0; index < 5u; ++index)
+    {
+        link5 link{};
+        BOOST_REQUIRE(instance.put_link(link, big_record{ add1(index) }));
+        BOOST_REQUIRE_EQUAL(link, index);
+    }
+
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 5u);
+
+    big_record record{};
+    for (uint32_t index = 0; index < 5u; ++index)
+    {
+        BOOST_REQUIRE(instance.get(index, record));
+        BOOST_REQUIRE_EQUAL(record.value, add1(index));
+    }
+
+    BOOST_REQUIRE(!instance.get(5, record));
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__record_allocate_set__segmented_body__padded)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 10 };
+    arraymap<link5, big_record::size> instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    // A two record allocation does not fit the remaining record, which pads.
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), 0u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(2), 2u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 4u);
+    BOOST_REQUIRE(instance.set(3, big_record{ 0x03030303_u32 }));
+    BOOST_REQUIRE(instance.set(2, big_record{ 0x02020202_u32 }));
+    BOOST_REQUIRE(instance.set(0, big_record{ 0x00000000_u32 }));
+
+    big_record record{};
+    BOOST_REQUIRE(instance.get(3, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x03030303_u32);
+    BOOST_REQUIRE(instance.get(2, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x02020202_u32);
+
+    // An allocation larger than a segment fails.
+    BOOST_REQUIRE(instance.allocate(3).is_terminal());
+    BOOST_REQUIRE_EQUAL(instance.count(), 4u);
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__slab_allocate_set__segmented_body__contiguous_in_segment)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 10 };
+    arraymap<link5, big_slab::size> instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(body_store.segment(), 10u);
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    // Two slabs (eight bytes) do not fit behind the first, so start the next.
+    constexpr auto size = big_slab::count();
+    BOOST_REQUIRE_EQUAL(instance.put_link(big_slab{ 0xa1b2c3d4_u32 }), 0u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(2 * size), 10u);
+    BOOST_REQUIRE(instance.set(10 + size, big_slab{ 0x01020304_u32 }));
+    BOOST_REQUIRE(instance.set(10, big_slab{ 0x05060708_u32 }));
+    BOOST_REQUIRE_EQUAL(body_store.count(), 2u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 18u);
+
+    big_slab slab{};
+    BOOST_REQUIRE(instance.get(0, slab));
+    BOOST_REQUIRE_EQUAL(slab.value, 0xa1b2c3d4_u32);
+    BOOST_REQUIRE(instance.get(10, slab));
+    BOOST_REQUIRE_EQUAL(slab.value, 0x05060708_u32);
+    BOOST_REQUIRE(instance.get(10 + size, slab));
+    BOOST_REQUIRE_EQUAL(slab.value, 0x01020304_u32);
+
+    // The write is limited to the count, even where the segment is not.
+    BOOST_REQUIRE(!instance.set(10, overrun_slab{ 0xa1b2c3d4_u32 }));
+    BOOST_REQUIRE(instance.get(10 + size, slab));
+    BOOST_REQUIRE_EQUAL(slab.value, 0x01020304_u32);
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
+BOOST_AUTO_TEST_CASE(arraymap__record_truncate__segmented_body__empties_segments)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 10 };
+    arraymap<link5, big_record::size> instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    for (uint32_t index = 0; index < 5u; ++index)
+        BOOST_REQUIRE(instance.put(big_record{ index }));
+
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+    BOOST_REQUIRE(instance.truncate(1));
+    BOOST_REQUIRE_EQUAL(instance.count(), 1u);
+    BOOST_REQUIRE_EQUAL(body_store.count(), 1u);
+
+    // Emptied segments are reused.
+    BOOST_REQUIRE(instance.put(big_record{ 0x41414141_u32 }));
+    BOOST_REQUIRE(instance.put(big_record{ 0x42424242_u32 }));
+    BOOST_REQUIRE_EQUAL(body_store.count(), 2u);
+
+    big_record record{};
+    BOOST_REQUIRE(instance.get(2, record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x42424242_u32);
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
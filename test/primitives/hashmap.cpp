@@ -614,6 +614,31 @@ BOOST_AUTO_TEST_CASE(hashmap__record_get_key__excess__expected)
     BOOST_REQUIRE_EQUAL(instance.get_key(0), key);
 }
 
+BOOST_AUTO_TEST_CASE(hashmap__record_get_memory__terminal__null)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    hashmap<link5, key1, big_record::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.get_memory(link5::terminal));
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__record_get_memory__put__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    hashmap<link5, key1, big_record::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    constexpr key1 key{ 0x41 };
+    BOOST_REQUIRE(!instance.put_link(key, big_record{ 0xa1b2c3d4_u32 }).is_terminal());
+
+    const auto memory = instance.get_memory(0);
+    BOOST_REQUIRE(memory);
+    BOOST_REQUIRE(memory->begin() == body_store.buffer().data());
+    BOOST_REQUIRE(*std::next(memory->begin(), link5::size) == 0x41u);
+}
+
 BOOST_AUTO_TEST_CASE(hashmap__record_put__excess__false)
 {
     test::chunk_storage head_store{};
@@ -796,6 +821,35 @@ BOOST_AUTO_TEST_CASE(hashmap__record_it__exists__non_terminal)
     BOOST_REQUIRE(instance.get(instance.it(key).self(), record));
 }
 
+BOOST_AUTO_TEST_CASE(hashmap__record_it__resumed__remaining)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    hashmap<link5, key1, big_record::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE(instance.create());
+
+    constexpr key1 key_a{ 0xaa };
+    constexpr key1 key_b{ 0xbb };
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a1_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_b, big_record{ 0x000000b1_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a2_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a3_u32 }).is_terminal());
+
+    auto it = instance.it(key_a);
+    BOOST_REQUIRE(it.advance());
+    const auto token = it.self();
+
+    big_record record{};
+    auto resumed = instance.it(key_a, token);
+    BOOST_REQUIRE_EQUAL(resumed.self(), token);
+    BOOST_REQUIRE(instance.get(resumed.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a2_u32);
+    BOOST_REQUIRE(resumed.advance());
+    BOOST_REQUIRE(instance.get(resumed.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a1_u32);
+    BOOST_REQUIRE(!resumed.advance());
+}
+
 BOOST_AUTO_TEST_CASE(hashmap__record_it__multiple__iterated)
 {
     test::chunk_storage head_store{};
@@ -1366,6 +1420,218 @@ BOOST_AUTO_TEST_CASE(hashmap__slab_body_count__non_empty_restore__truncates)
     BOOST_REQUIRE_EQUAL(body_store.buffer(), base16_chunk("123456"));
 }
 
+// segmented body
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(hashmap__record_put__segmented_body__expected)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    // Twenty five byte segments are aligned to two (ten byte) records.
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 25 };
+    hashmap<link5, key1, big_record::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE_EQUAL(body_store.segment(), 20u);
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    for (uint8_t index = 0; index < 5u; ++index)
+    {
+        link5 link{};
+        BOOST_REQUIRE(instance.put_link(link, key1{ index }, big_record{ add1<uint32_t>(index) }));
+        BOOST_REQUIRE_EQUAL(link, index);
+    }
+
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 5u);
+
+    big_record record{};
+    for (uint8_t index = 0; index < 5u; ++index)
+    {
+        BOOST_REQUIRE(instance.exists(key1{ index }));
+        BOOST_REQUIRE_EQUAL(instance.first(key1{ index }), index);
+        BOOST_REQUIRE_EQUAL(instance.get_key(index), key1{ index });
+        BOOST_REQUIRE(instance.get(index, record));
+        BOOST_REQUIRE_EQUAL(record.value, add1<uint32_t>(index));
+    }
+
+    BOOST_REQUIRE(!instance.exists(key1{ 0x42 }));
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__record_it__segmented_body__iterated)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 25 };
+    hashmap<link5, key1, big_record::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    // Each record links to its predecessor in a prior segment.
+    constexpr key1 key_a{ 0xaa };
+    constexpr key1 key_b{ 0xbb };
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a1_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_b, big_record{ 0x000000b1_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a2_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_b, big_record{ 0x000000b2_u32 }).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key_a, big_record{ 0x000000a3_u32 }).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+
+    big_record record{};
+    auto it = instance.it(key_a);
+    BOOST_REQUIRE_EQUAL(it.self(), 4u);
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a3_u32);
+    BOOST_REQUIRE(it.advance());
+    BOOST_REQUIRE_EQUAL(it.self(), 2u);
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a2_u32);
+    BOOST_REQUIRE(it.advance());
+    BOOST_REQUIRE_EQUAL(it.self(), 0u);
+    BOOST_REQUIRE(instance.get(it.self(), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x000000a1_u32);
+    BOOST_REQUIRE(!it.advance());
+
+    // Resumed in a prior segment.
+    auto resumed = instance.it(key_b, 1);
+    BOOST_REQUIRE_EQUAL(resumed.self(), 1u);
+    BOOST_REQUIRE(!resumed.advance());
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__slab_put__segmented_body__padded)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    // Slabs (ten bytes) that do not fit a segment start the next.
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 25 };
+    hashmap<link5, key1, big_slab::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE_EQUAL(body_store.segment(), 25u);
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    constexpr key1 key{ 0x41 };
+    const std_vector<size_t> expected{ 0, 10, 25, 35, 50 };
+    for (size_t index = 0; index < expected.size(); ++index)
+    {
+        link5 link{};
+        BOOST_REQUIRE(instance.put_link(link, key, big_slab{ possible_narrow_cast<uint32_t>(index) }));
+        BOOST_REQUIRE_EQUAL(link, expected.at(index));
+    }
+
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 60u);
+
+    big_slab slab{};
+    auto it = instance.it(key);
+    for (auto index = expected.size(); !is_zero(index); --index)
+    {
+        BOOST_REQUIRE_EQUAL(it.self(), expected.at(sub1(index)));
+        BOOST_REQUIRE(instance.get(it.self(), slab));
+        BOOST_REQUIRE_EQUAL(slab.value, sub1(index));
+        BOOST_REQUIRE_EQUAL(it.advance(), !is_one(index));
+    }
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__allocate_put__segmented_body__expected)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 25 };
+    hashmap<link5, key1, big_record::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    // A two record allocation does not fit the remaining record, which pads.
+    BOOST_REQUIRE_EQUAL(instance.allocate(1), 0u);
+    BOOST_REQUIRE_EQUAL(instance.allocate(2), 2u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 4u);
+    BOOST_REQUIRE(instance.put(3, key1{ 0x03 }, big_record{ 0x03030303_u32 }));
+    BOOST_REQUIRE(instance.put(2, key1{ 0x02 }, big_record{ 0x02020202_u32 }));
+    BOOST_REQUIRE(instance.put(0, key1{ 0x00 }, big_record{ 0x00000000_u32 }));
+
+    big_record record{};
+    BOOST_REQUIRE(instance.get(instance.first(key1{ 0x03 }), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x03030303_u32);
+    BOOST_REQUIRE(instance.get(instance.first(key1{ 0x02 }), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x02020202_u32);
+    BOOST_REQUIRE_EQUAL(instance.first(key1{ 0x00 }), 0u);
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
+BOOST_AUTO_TEST_CASE(hashmap__record_restore__segmented_body__truncates_segments)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 25 };
+    hashmap<link5, key1, big_record::size> instance{ head_store, body_store, buckets };
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    BOOST_REQUIRE(instance.put(key1{ 0x01 }, big_record{ 0x01010101_u32 }));
+    BOOST_REQUIRE(instance.put(key1{ 0x02 }, big_record{ 0x02020202_u32 }));
+    BOOST_REQUIRE(instance.put(key1{ 0x03 }, big_record{ 0x03030303_u32 }));
+    BOOST_REQUIRE(instance.backup());
+    const auto backup = head_store.buffer();
+    BOOST_REQUIRE(instance.put(key1{ 0x04 }, big_record{ 0x04040404_u32 }));
+    BOOST_REQUIRE(instance.put(key1{ 0x05 }, big_record{ 0x05050505_u32 }));
+    BOOST_REQUIRE(instance.put(key1{ 0x06 }, big_record{ 0x06060606_u32 }));
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+
+    // The backed up head references only the first three records.
+    head_store.buffer() = backup;
+    BOOST_REQUIRE(instance.restore());
+    BOOST_REQUIRE(!instance.exists(key1{ 0x06 }));
+    BOOST_REQUIRE_EQUAL(instance.count(), 3u);
+    BOOST_REQUIRE_EQUAL(body_store.count(), 2u);
+    BOOST_REQUIRE_EQUAL(body_store.size(), 30u);
+
+    // Emptied segment is reused.
+    BOOST_REQUIRE(instance.put(key1{ 0x04 }, big_record{ 0x04040404_u32 }));
+    BOOST_REQUIRE(instance.put(key1{ 0x05 }, big_record{ 0x05050505_u32 }));
+
+    big_record record{};
+    BOOST_REQUIRE(instance.get(instance.first(key1{ 0x05 }), record));
+    BOOST_REQUIRE_EQUAL(record.value, 0x05050505_u32);
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
 ////std::cout << head_file << std::endl << std::endl;
 ////std::cout << body_file << std::endl << std::endl;
 
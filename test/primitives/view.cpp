@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../test.hpp"
+#include "../mocks/chunk_storage.hpp"
+
+BOOST_AUTO_TEST_SUITE(view_tests)
+
+using namespace system;
+
+// Prefix of 2 bytes, element of 8 bytes (data begins at offset 2).
+class view_
+  : public view<2, 8>
+{
+public:
+    using base = view<2, 8>;
+    using base::view;
+
+    uint8_t byte1() const NOEXCEPT
+    {
+        return base::read_byte<1>();
+    }
+
+    uint32_t int3() const NOEXCEPT
+    {
+        return base::read_little_endian<1, uint32_t, 3>();
+    }
+
+    uint64_t int8() const NOEXCEPT
+    {
+        return base::read_little_endian<0, uint64_t>();
+    }
+};
+
+// Prefix of 1 byte, element of a hash.
+class hash_view_
+  : public view<1, hash_size>
+{
+public:
+    using base = view<1, hash_size>;
+    using base::view;
+
+    hash_digest hash() const NOEXCEPT
+    {
+        return base::read_hash<0>();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(view__construct__default__invalid)
+{
+    const view_ instance{};
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE_EQUAL(instance.byte1(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.int3(), 0u);
+    BOOST_REQUIRE_EQUAL(instance.int8(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(view__construct__null__invalid)
+{
+    const view_ instance{ memory_ptr{} };
+    BOOST_REQUIRE(!instance);
+}
+
+BOOST_AUTO_TEST_CASE(view__construct__truncated__invalid)
+{
+    data_chunk body{ 0x00, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+    test::chunk_storage store{ body };
+    const view_ instance{ store.get() };
+    BOOST_REQUIRE(!instance);
+    BOOST_REQUIRE_EQUAL(instance.int8(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(view__read__unaligned__expected)
+{
+    data_chunk body{ 0xff, 0xff, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+    test::chunk_storage store{ body };
+    const view_ instance{ store.get() };
+    BOOST_REQUIRE(instance);
+    BOOST_REQUIRE_EQUAL(instance.byte1(), 0x02u);
+    BOOST_REQUIRE_EQUAL(instance.int3(), 0x00040302_u32);
+    BOOST_REQUIRE_EQUAL(instance.int8(), 0x0807060504030201_u64);
+}
+
+BOOST_AUTO_TEST_CASE(view__read_hash__offset__expected)
+{
+    data_chunk body{ 0xff };
+    body.insert(body.end(), one_hash.begin(), one_hash.end());
+    test::chunk_storage store{ body };
+    const hash_view_ instance{ store.get() };
+    BOOST_REQUIRE(instance);
+    BOOST_REQUIRE_EQUAL(instance.hash(), one_hash);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1180,6 +1180,90 @@ BOOST_AUTO_TEST_CASE(query_archival__get_transactions__found__expected)
     BOOST_REQUIRE_EQUAL(query.get_transactions(2)->size(), 2u);
 }
 
+BOOST_AUTO_TEST_CASE(query_archival__get_block_data__genesis__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+
+    system::data_chunk out{};
+    BOOST_REQUIRE(query.get_block_data(out, 0, true));
+    BOOST_REQUIRE_EQUAL(out, test::genesis.to_data(true));
+    BOOST_REQUIRE(query.get_block_data(out, 0, false));
+    BOOST_REQUIRE_EQUAL(out, test::genesis.to_data(false));
+    BOOST_REQUIRE(!query.get_block_data(out, 1, true));
+}
+
+BOOST_AUTO_TEST_CASE(query_archival__get_block_data__witness__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.set(test::block2a, test::context));
+
+    system::data_chunk out{};
+    BOOST_REQUIRE(query.get_block_data(out, 1, true));
+    BOOST_REQUIRE_EQUAL(out, test::block1a.to_data(true));
+    BOOST_REQUIRE(query.get_block_data(out, 1, false));
+    BOOST_REQUIRE_EQUAL(out, test::block1a.to_data(false));
+    BOOST_REQUIRE(query.get_block_data(out, 2, true));
+    BOOST_REQUIRE_EQUAL(out, test::block2a.to_data(true));
+    BOOST_REQUIRE(query.get_block_data(out, 2, false));
+    BOOST_REQUIRE_EQUAL(out, test::block2a.to_data(false));
+}
+
+BOOST_AUTO_TEST_CASE(query_archival__write_block__stripped__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+
+    size_t size{};
+    BOOST_REQUIRE(query.get_block_size(size, 1, false));
+    BOOST_REQUIRE_EQUAL(size, test::block1a.serialized_size(false));
+    BOOST_REQUIRE(query.get_block_size(size, 1, true));
+    BOOST_REQUIRE_EQUAL(size, test::block1a.serialized_size(true));
+    BOOST_REQUIRE(!query.get_block_size(size, 2, true));
+
+    system::data_chunk out(test::block1a.serialized_size(false));
+    system::write::bytes::copy sink{ out };
+    BOOST_REQUIRE(query.write_block(sink, 1, false));
+    BOOST_REQUIRE_EQUAL(sink.get_write_position(), out.size());
+    BOOST_REQUIRE_EQUAL(out, test::block1a.to_data(false));
+}
+
+BOOST_AUTO_TEST_CASE(query_archival__get_transaction_data__separate_witness_compact_amounts__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    settings.separate_witness = true;
+    settings.compact_amounts = true;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+
+    const auto& tx = *test::block1a.transactions_ptr()->front();
+    system::data_chunk out{};
+    BOOST_REQUIRE(query.get_transaction_data(out, 1, true));
+    BOOST_REQUIRE_EQUAL(out, tx.to_data(true));
+    BOOST_REQUIRE(query.get_transaction_data(out, 1, false));
+    BOOST_REQUIRE_EQUAL(out, tx.to_data(false));
+    BOOST_REQUIRE(!query.get_transaction_data(out, 2, true));
+}
+
 BOOST_AUTO_TEST_CASE(query_archival__get_point__null_point__expected)
 {
     settings settings{};
@@ -114,6 +114,69 @@ BOOST_AUTO_TEST_CASE(query_confirmation__is_confirmed_block__push_pop_confirmed_
     BOOST_REQUIRE(!query.is_confirmed_block(2));
 }
 
+BOOST_AUTO_TEST_CASE(query_confirmation__get_candidate_header__push_pop_candidate__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, { 0, 1, 0 }));
+    BOOST_REQUIRE(query.set(test::block2, { 0, 2, 0 }));
+
+    test::query_accessor::chain_header header{};
+    BOOST_REQUIRE(query.get_candidate_header(header, 0));
+    BOOST_REQUIRE(!query.get_candidate_header(header, 1));
+    BOOST_REQUIRE_EQUAL(header.link, 0u);
+    BOOST_REQUIRE_EQUAL(header.hash, test::genesis.hash());
+    BOOST_REQUIRE_EQUAL(header.bits, test::genesis.header().bits());
+    BOOST_REQUIRE_EQUAL(header.timestamp, test::genesis.header().timestamp());
+    BOOST_REQUIRE_EQUAL(header.version, test::genesis.header().version());
+
+    BOOST_REQUIRE(query.push_candidate(1));
+    BOOST_REQUIRE(query.push_candidate(2));
+    BOOST_REQUIRE(query.get_candidate_header(header, 2));
+    BOOST_REQUIRE_EQUAL(header.link, 2u);
+    BOOST_REQUIRE_EQUAL(header.hash, test::block2.hash());
+    BOOST_REQUIRE_EQUAL(header.ctx.height, 2u);
+
+    BOOST_REQUIRE(query.pop_candidate());
+    BOOST_REQUIRE(!query.get_candidate_header(header, 2));
+    BOOST_REQUIRE(query.get_candidate_header(header, 1));
+    BOOST_REQUIRE_EQUAL(header.hash, test::block1.hash());
+
+    // The confirmed chain is cached independently.
+    BOOST_REQUIRE(!query.get_confirmed_header(header, 1));
+    BOOST_REQUIRE(query.get_confirmed_header(header, 0));
+    BOOST_REQUIRE_EQUAL(header.hash, test::genesis.hash());
+}
+
+BOOST_AUTO_TEST_CASE(query_confirmation__get_confirmed_header__reorganized_elsewhere__resynchronized)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    test::query_accessor other{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, { 0, 1, 0 }));
+    BOOST_REQUIRE(query.set(test::block1b, { 0, 1, 0 }));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    test::query_accessor::chain_header header{};
+    BOOST_REQUIRE(query.get_confirmed_header(header, 1));
+    BOOST_REQUIRE_EQUAL(header.hash, test::block1.hash());
+
+    // Same height, different top, not pushed through the cached instance.
+    BOOST_REQUIRE(other.pop_confirmed());
+    BOOST_REQUIRE(other.push_confirmed(2));
+    BOOST_REQUIRE(query.get_confirmed_header(header, 1));
+    BOOST_REQUIRE_EQUAL(header.link, 2u);
+    BOOST_REQUIRE_EQUAL(header.hash, test::block1b.hash());
+}
+
 BOOST_AUTO_TEST_CASE(query_confirmation__is_confirmed_tx__confirm__expected)
 {
     settings settings{};
@@ -241,6 +241,40 @@ BOOST_AUTO_TEST_CASE(query_initialization__get_fork__confirmed_ahead__expected)
     BOOST_REQUIRE_EQUAL(query.get_fork(), 1u);
 }
 
+BOOST_AUTO_TEST_CASE(query_initialization__get_fork__reorganized__updated)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, test::context));
+    BOOST_REQUIRE(query.set(test::block2, test::context));
+    BOOST_REQUIRE(query.set(test::block3, test::context));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.push_candidate(1));
+    BOOST_REQUIRE(query.push_candidate(2));
+    BOOST_REQUIRE(query.push_candidate(3));
+    BOOST_REQUIRE(query.push_confirmed(1));
+    BOOST_REQUIRE(query.push_confirmed(2));
+    BOOST_REQUIRE_EQUAL(query.get_fork(), 2u);
+    BOOST_REQUIRE_EQUAL(query.get_fork(), 2u);
+
+    // Candidate chain reorganized below the confirmed top.
+    BOOST_REQUIRE(query.pop_candidate());
+    BOOST_REQUIRE(query.pop_candidate());
+    BOOST_REQUIRE(query.pop_candidate());
+    BOOST_REQUIRE(query.push_candidate(4));
+    BOOST_REQUIRE_EQUAL(query.get_fork(), 0u);
+
+    // Confirmed chain reorganized to the candidate chain.
+    BOOST_REQUIRE(query.pop_confirmed());
+    BOOST_REQUIRE(query.pop_confirmed());
+    BOOST_REQUIRE(query.push_confirmed(4));
+    BOOST_REQUIRE_EQUAL(query.get_fork(), 1u);
+}
+
 // get_last_associated_from
 
 BOOST_AUTO_TEST_CASE(query_initialization__get_last_associated_from__terminal__max_size_t)
@@ -360,6 +394,35 @@ BOOST_AUTO_TEST_CASE(query_initialization__get_all_unassociated_above__gapped_ca
     BOOST_REQUIRE_EQUAL(unassociated.size(), 0u);
 }
 
+BOOST_AUTO_TEST_CASE(query_initialization__get_all_unassociated_above__associated_later__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    test::query_accessor other{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1.header(), test::context)); // header only
+    BOOST_REQUIRE(query.set(test::block2.header(), test::context)); // header only
+    BOOST_REQUIRE(query.push_candidate(query.to_header(test::block1.hash())));
+    BOOST_REQUIRE(query.push_candidate(query.to_header(test::block2.hash())));
+    BOOST_REQUIRE_EQUAL(query.get_all_unassociated_above(0).size(), 2u);
+    BOOST_REQUIRE_EQUAL(query.get_last_associated_from(0), 0u);
+
+    // Associated by this instance.
+    BOOST_REQUIRE(query.set(test::block1, test::context));
+    auto unassociated = query.get_all_unassociated_above(0);
+    BOOST_REQUIRE_EQUAL(unassociated.size(), 1u);
+    BOOST_REQUIRE_EQUAL(unassociated.front(), test::block2.hash());
+    BOOST_REQUIRE_EQUAL(query.get_last_associated_from(0), 1u);
+
+    // Associated by another instance.
+    BOOST_REQUIRE(other.set(test::block2, test::context));
+    BOOST_REQUIRE(query.get_all_unassociated_above(0).empty());
+    BOOST_REQUIRE_EQUAL(query.get_last_associated_from(0), 2u);
+}
+
 // get_hashes
 
 BOOST_AUTO_TEST_CASE(query_initialization__get_hashes__initialized__one)
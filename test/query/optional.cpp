@@ -17,6 +17,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../test.hpp"
+#include <atomic>
+#include <thread>
 #include "../mocks/blocks.hpp"
 #include "../mocks/chunk_store.hpp"
 
@@ -40,12 +42,28 @@ struct query_optional_setup_fixture
 
 BOOST_FIXTURE_TEST_SUITE(query_optional_tests, query_optional_setup_fixture)
 
-constexpr auto genesis_address = system::base16_array("023a37945feac5597732cd736c1512c5997fec3d23767741a2b79a719f5f23e5");
+const auto& genesis_address = test::genesis.transactions_ptr()->front()->outputs_ptr()->front()->script();
+const system::chain::script other_address{ { { system::chain::opcode::pick } } };
 
-BOOST_AUTO_TEST_CASE(query_optional__address_hash__genesis__expected)
+BOOST_AUTO_TEST_CASE(query_optional__to_address_outputs__script_mismatch__false)
 {
-    const auto& output = *test::genesis.transactions_ptr()->front()->outputs_ptr()->front();
-    BOOST_REQUIRE_EQUAL(test::query_accessor::address_hash(output), genesis_address);
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+
+    // Indexed under the other script id, but the output script differs.
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(0, 0)));
+
+    output_links out{};
+    BOOST_REQUIRE(!query.to_address_outputs(out, other_address));
+    BOOST_REQUIRE(out.empty());
+    BOOST_REQUIRE(!query.to_address_outputs(out, genesis_address));
+
+    uint64_t balance{};
+    BOOST_REQUIRE(!query.get_confirmed_balance(balance, other_address));
 }
 
 BOOST_AUTO_TEST_CASE(query_optional__get_confirmed_balance__genesis__expected)
@@ -145,6 +163,521 @@ BOOST_AUTO_TEST_CASE(query_optional__to_minimum_unspent_outputs__below__included
     BOOST_REQUIRE_EQUAL(out.front(), 0);
 }
 
+// Coinbase of three other_address outputs with distinct values.
+const system::chain::block coins_block
+{
+    system::chain::header
+    {
+        0x31323334,
+        test::genesis.hash(),
+        system::null_hash,
+        0x41424344,
+        0x51525354,
+        0x61626364
+    },
+    system::chain::transactions
+    {
+        system::chain::transaction
+        {
+            0xc1,
+            system::chain::inputs
+            {
+                system::chain::input
+                {
+                    system::chain::point{},
+                    system::chain::script{ { { system::chain::opcode::size } } },
+                    system::chain::witness{},
+                    0xc1
+                }
+            },
+            system::chain::outputs
+            {
+                system::chain::output{ 0x30, other_address },
+                system::chain::output{ 0x10, other_address },
+                system::chain::output{ 0x20, other_address }
+            },
+            0xc1
+        }
+    }
+};
+
+BOOST_AUTO_TEST_CASE(query_optional__to_minimum_unspent_outputs__coins__ascending)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(coins_block, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+
+    output_links out{};
+    BOOST_REQUIRE(query.to_minimum_unspent_outputs(out, other_address, 0x15));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(1, 2));
+    BOOST_REQUIRE_EQUAL(out.at(1), query.to_output(1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__to_largest_unspent_outputs__coins__descending)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(coins_block, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+
+    output_links out{};
+    BOOST_REQUIRE(query.to_largest_unspent_outputs(out, other_address, 2));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(1, 0));
+    BOOST_REQUIRE_EQUAL(out.at(1), query.to_output(1, 2));
+
+    BOOST_REQUIRE(query.to_largest_unspent_outputs(out, other_address, 10));
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+    BOOST_REQUIRE_EQUAL(out.at(2), query.to_output(1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__to_sufficient_unspent_output__reorganized__invalidated)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(coins_block, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+
+    output_link out{};
+    BOOST_REQUIRE(query.to_sufficient_unspent_output(out, other_address, 0x11));
+    BOOST_REQUIRE_EQUAL(out, query.to_output(1, 2));
+    BOOST_REQUIRE(query.to_sufficient_unspent_output(out, other_address, 0x30));
+    BOOST_REQUIRE_EQUAL(out, query.to_output(1, 0));
+    BOOST_REQUIRE(query.to_sufficient_unspent_output(out, other_address, 0x31));
+    BOOST_REQUIRE(out.is_terminal());
+
+    // Popping the block invalidates the cached coins.
+    BOOST_REQUIRE(query.set_unstrong(1));
+    BOOST_REQUIRE(query.pop_confirmed());
+    BOOST_REQUIRE(query.to_sufficient_unspent_output(out, other_address, 0x11));
+    BOOST_REQUIRE(out.is_terminal());
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__to_sufficient_unspent_output__indexed_after_read__invalidated)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(coins_block, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.push_confirmed(1));
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(1, 1)));
+
+    // Cached before the block is indexed.
+    output_link out{};
+    BOOST_REQUIRE(query.to_sufficient_unspent_output(out, other_address, 0x10));
+    BOOST_REQUIRE_EQUAL(out, query.to_output(1, 1));
+    BOOST_REQUIRE(query.to_sufficient_unspent_output(out, other_address, 0x30));
+    BOOST_REQUIRE(out.is_terminal());
+
+    // Indexing adds rows under the same confirmed top.
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 2u);
+    BOOST_REQUIRE(query.to_sufficient_unspent_output(out, other_address, 0x30));
+    BOOST_REQUIRE_EQUAL(out, query.to_output(1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__to_address_page__paged__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(1, 0)));
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(2, 0)));
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(2, 1)));
+
+    output_links out{};
+    address_link cursor{};
+    BOOST_REQUIRE(query.to_address_page(out, cursor, other_address, 2));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(2, 1));
+    BOOST_REQUIRE_EQUAL(out.at(1), query.to_output(2, 0));
+    BOOST_REQUIRE(!cursor.is_terminal());
+
+    BOOST_REQUIRE(query.to_address_page(out, cursor, other_address, 2));
+    BOOST_REQUIRE_EQUAL(out.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(1, 0));
+    BOOST_REQUIRE(cursor.is_terminal());
+
+    // Empty history is not a failure.
+    BOOST_REQUIRE(query.to_address_page(out, cursor, genesis_address, 2));
+    BOOST_REQUIRE(out.empty());
+    BOOST_REQUIRE(cursor.is_terminal());
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__to_address_page__height_range__confirmed_only)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE(query.push_confirmed(2));
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(1, 0)));
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(2, 0)));
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(2, 1)));
+
+    output_links out{};
+    address_link cursor{};
+    BOOST_REQUIRE(query.to_address_page(out, cursor, other_address, 10, 1, 1));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+    BOOST_REQUIRE(cursor.is_terminal());
+
+    BOOST_REQUIRE(query.to_address_page(out, cursor, other_address, 10, 2));
+    BOOST_REQUIRE(out.empty());
+    BOOST_REQUIRE(cursor.is_terminal());
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__index_addresses__confirmed__checkpointed)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.push_confirmed(1));
+    BOOST_REQUIRE_EQUAL(query.get_address_checkpoint(), 0u);
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 1));
+    BOOST_REQUIRE_EQUAL(indexed, 1u);
+    BOOST_REQUIRE_EQUAL(query.get_address_checkpoint(), 1u);
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 1u);
+    BOOST_REQUIRE_EQUAL(query.get_address_checkpoint(), 2u);
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 0u);
+
+    output_links out{};
+    BOOST_REQUIRE(query.to_address_outputs(out, genesis_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.front(), query.to_output(0, 0));
+    BOOST_REQUIRE(query.to_address_outputs(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.front(), query.to_output(1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__index_addresses__concurrent__applied_once)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    // Both indexers start from the same checkpoint, only one may apply it.
+    std::atomic_bool success{ true };
+    std::atomic<size_t> total{};
+    const auto index = [&]() NOEXCEPT
+    {
+        size_t indexed{};
+        success = query.index_addresses(indexed, 10) && success;
+        total += indexed;
+    };
+
+    std::thread first(index);
+    std::thread second(index);
+    first.join();
+    second.join();
+    BOOST_REQUIRE(success);
+    BOOST_REQUIRE_EQUAL(total, 2u);
+    BOOST_REQUIRE_EQUAL(query.get_address_checkpoint(), 2u);
+
+    uint64_t value{};
+    size_t outputs{};
+    BOOST_REQUIRE(query.get_cached_balance(value, outputs, genesis_address));
+    BOOST_REQUIRE_EQUAL(value, 5000000000u);
+    BOOST_REQUIRE_EQUAL(outputs, 1u);
+
+    output_links out{};
+    BOOST_REQUIRE(query.to_address_outputs(out, genesis_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__index_addresses__reorganized__rewound)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 2u);
+
+    // Reorganize block1a to block1b.
+    BOOST_REQUIRE(query.pop_confirmed());
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE(query.push_confirmed(2));
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 1u);
+    BOOST_REQUIRE_EQUAL(query.get_address_checkpoint(), 2u);
+
+    // Rows of the popped block remain, but are not duplicated.
+    output_links out{};
+    BOOST_REQUIRE(query.to_address_outputs(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+
+    // Rows of the popped block no longer carry a height.
+    BOOST_REQUIRE(query.to_address_history(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(2, 0));
+    BOOST_REQUIRE_EQUAL(out.at(1), query.to_output(2, 1));
+
+    // Only the confirmed block1b outputs are unspent.
+    BOOST_REQUIRE(query.to_unspent_outputs(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__to_address_history__indexed__height_ordered)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.set(test::block2b, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE(query.push_confirmed(1));
+    BOOST_REQUIRE(query.push_confirmed(2));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 3u);
+
+    // Chain order is most recent first.
+    output_links out{};
+    address_link cursor{};
+    BOOST_REQUIRE(query.to_address_page(out, cursor, other_address, 10));
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+    BOOST_REQUIRE_EQUAL(out.front(), query.to_output(2, 0));
+
+    BOOST_REQUIRE(query.to_address_history(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(1, 0));
+    BOOST_REQUIRE_EQUAL(out.at(1), query.to_output(1, 1));
+    BOOST_REQUIRE_EQUAL(out.at(2), query.to_output(2, 0));
+
+    BOOST_REQUIRE(query.to_address_history(out, other_address, 2));
+    BOOST_REQUIRE_EQUAL(out.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.front(), query.to_output(2, 0));
+
+    BOOST_REQUIRE(query.to_address_history(out, other_address, 0, 1));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+
+    BOOST_REQUIRE(query.to_address_history(out, genesis_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 1u);
+    BOOST_REQUIRE_EQUAL(out.front(), query.to_output(0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__index_addresses__popped_top__lower_rows_confirmed)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.set(test::block2b, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE(query.push_confirmed(1));
+    BOOST_REQUIRE(query.push_confirmed(2));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 3u);
+
+    // Pop block2b, unindexed by the next batch.
+    BOOST_REQUIRE(query.set_unstrong(2));
+    BOOST_REQUIRE(query.pop_confirmed());
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 0u);
+    BOOST_REQUIRE_EQUAL(query.get_address_checkpoint(), 2u);
+
+    // The popped row is unconfirmed, rows below the fork are not walked.
+    output_links out{};
+    BOOST_REQUIRE(query.to_address_history(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(1, 0));
+    BOOST_REQUIRE_EQUAL(out.at(1), query.to_output(1, 1));
+
+    BOOST_REQUIRE(query.to_address_outputs(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__index_addresses__popped_after_set_address_output__unconfirmed)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.set(test::block2b, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE(query.push_confirmed(1));
+    BOOST_REQUIRE(query.push_confirmed(2));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 3u);
+
+    // A row for a lower height is prepended above the indexed rows.
+    BOOST_REQUIRE(query.set_address_output(other_address, query.to_output(1, 0)));
+
+    // Pop block2b, unindexed by the next batch.
+    BOOST_REQUIRE(query.set_unstrong(2));
+    BOOST_REQUIRE(query.pop_confirmed());
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 0u);
+
+    // The popped row is unconfirmed, the prepended row resolves to height 1.
+    output_links out{};
+    BOOST_REQUIRE(query.to_address_history(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 2u);
+    BOOST_REQUIRE_EQUAL(out.at(0), query.to_output(1, 0));
+    BOOST_REQUIRE_EQUAL(out.at(1), query.to_output(1, 1));
+
+    // Unconfirmed rows resolve once their tx is confirmed again.
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE(query.push_confirmed(2));
+    BOOST_REQUIRE(query.to_address_history(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 3u);
+    BOOST_REQUIRE_EQUAL(out.at(2), query.to_output(2, 0));
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__get_cached_balance__not_indexed__false)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set_address_output(genesis_address, query.to_output(0, 0)));
+
+    uint64_t value{};
+    size_t outputs{};
+    BOOST_REQUIRE(!query.get_cached_balance(value, outputs, genesis_address));
+
+    // Falls back to the address index.
+    BOOST_REQUIRE(query.get_confirmed_balance(value, genesis_address));
+    BOOST_REQUIRE_EQUAL(value, 5000000000u);
+}
+
+BOOST_AUTO_TEST_CASE(query_optional__get_cached_balance__reorganized__expected)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block_spend_genesis, test::context));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 2u);
+
+    uint64_t value{};
+    size_t outputs{};
+    BOOST_REQUIRE(query.get_cached_balance(value, outputs, genesis_address));
+    BOOST_REQUIRE_EQUAL(value, 0u);
+    BOOST_REQUIRE_EQUAL(outputs, 0u);
+    BOOST_REQUIRE(query.get_cached_balance(value, outputs, other_address));
+    BOOST_REQUIRE_EQUAL(value, 0x86u);
+    BOOST_REQUIRE_EQUAL(outputs, 1u);
+
+    // Equal counts, but the indexed top is the popped block.
+    BOOST_REQUIRE(query.set_unstrong(1));
+    BOOST_REQUIRE(query.pop_confirmed());
+    BOOST_REQUIRE(query.set_strong(2));
+    BOOST_REQUIRE(query.push_confirmed(2));
+    BOOST_REQUIRE_EQUAL(query.get_address_checkpoint(), 2u);
+    BOOST_REQUIRE(!query.get_cached_balance(value, outputs, genesis_address));
+    BOOST_REQUIRE(!query.get_cached_balance(value, outputs, other_address));
+
+    // Falls back to the address index of the confirmed chain.
+    BOOST_REQUIRE(query.get_confirmed_balance(value, genesis_address));
+    BOOST_REQUIRE_EQUAL(value, 5000000000u);
+
+    // Reorganize block_spend_genesis to block1b.
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+    BOOST_REQUIRE_EQUAL(indexed, 1u);
+    BOOST_REQUIRE(query.get_cached_balance(value, outputs, genesis_address));
+    BOOST_REQUIRE_EQUAL(value, 5000000000u);
+    BOOST_REQUIRE_EQUAL(outputs, 1u);
+    BOOST_REQUIRE(query.get_cached_balance(value, outputs, other_address));
+    BOOST_REQUIRE_EQUAL(value, 2u * 0xb1u);
+    BOOST_REQUIRE_EQUAL(outputs, 2u);
+
+    // Consistent with the address index (not cached).
+    output_links out{};
+    BOOST_REQUIRE(query.to_unspent_outputs(out, other_address));
+    BOOST_REQUIRE_EQUAL(out.size(), outputs);
+    BOOST_REQUIRE(query.to_unspent_outputs(out, genesis_address));
+    BOOST_REQUIRE_EQUAL(out.size(), 1u);
+}
+
 BOOST_AUTO_TEST_CASE(query_optional__set_filter__get_filter_and_head__expected)
 {
     const auto& filter_head0 = system::null_hash;
@@ -175,6 +708,61 @@ BOOST_AUTO_TEST_CASE(query_optional__set_filter__get_filter_and_head__expected)
     BOOST_REQUIRE_EQUAL(out, filter1);
 }
 
+BOOST_AUTO_TEST_CASE(query_optional__get_filters__confirmed_range__expected)
+{
+    const auto& filter_head0 = system::null_hash;
+    const auto filter0 = system::base16_chunk("0102030405060708090a0b0c0d0e0f");
+    const auto& filter_head1 = system::one_hash;
+    const auto filter1 = system::base16_chunk("102030405060708090a0b0c0d0e0f0102030405060708090a0b0c0d0e0f0");
+
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1a, {}));
+    BOOST_REQUIRE(query.push_confirmed(1));
+    BOOST_REQUIRE(query.set_filter(0, filter_head0, filter0));
+    BOOST_REQUIRE(query.set_filter(1, filter_head1, filter1));
+
+    hashes heads{};
+    BOOST_REQUIRE(query.get_filter_heads(heads, 0, 2));
+    BOOST_REQUIRE_EQUAL(heads.size(), 2u);
+    BOOST_REQUIRE_EQUAL(heads.front(), filter_head0);
+    BOOST_REQUIRE_EQUAL(heads.back(), filter_head1);
+    BOOST_REQUIRE(!query.get_filter_heads(heads, 1, 2));
+
+    std_vector<system::data_chunk> filters{};
+    BOOST_REQUIRE(query.get_filters(0, 2, [&](size_t height,
+        const hash_digest& head, const system::data_slice& filter) NOEXCEPT
+    {
+        BOOST_REQUIRE_EQUAL(head, heads.at(height));
+        filters.push_back(filter.to_chunk());
+        return true;
+    }));
+
+    BOOST_REQUIRE_EQUAL(filters.size(), 2u);
+    BOOST_REQUIRE_EQUAL(filters.front(), filter0);
+    BOOST_REQUIRE_EQUAL(filters.back(), filter1);
+
+    // Handler terminates iteration.
+    size_t calls{};
+    BOOST_REQUIRE(query.get_filters(0, 2, [&](size_t, const hash_digest&,
+        const system::data_slice&) NOEXCEPT
+    {
+        return is_zero(calls++);
+    }));
+    BOOST_REQUIRE_EQUAL(calls, 1u);
+
+    // Range beyond confirmed top.
+    BOOST_REQUIRE(!query.get_filters(1, 2, [](size_t, const hash_digest&,
+        const system::data_slice&) NOEXCEPT
+    {
+        return true;
+    }));
+}
+
 BOOST_AUTO_TEST_CASE(query_optional__set_buffered_tx__get_buffered_tx__expected)
 {
     settings settings{};
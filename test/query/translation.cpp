@@ -342,6 +342,66 @@ BOOST_AUTO_TEST_CASE(query_translation__to_output_tx__to_output__expected)
     BOOST_REQUIRE_EQUAL(store.output_body(), output_body);
 }
 
+BOOST_AUTO_TEST_CASE(query_translation__set_link_tx__puts__contiguous_and_readable)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+
+    const auto& tx = *test::block1a.transactions_ptr()->front();
+    const auto link = query.set_link(tx);
+    BOOST_REQUIRE(!link.is_terminal());
+
+    const auto& ins = *tx.inputs_ptr();
+    const auto in_fks = query.to_tx_inputs(link);
+    BOOST_REQUIRE_EQUAL(in_fks.size(), ins.size());
+
+    // Each input slab directly follows the preceding input slab of the tx.
+    for (uint32_t index = 0; index < ins.size(); ++index)
+    {
+        BOOST_REQUIRE_EQUAL(query.to_input(link, index), in_fks.at(index));
+        const auto input = query.get_input(in_fks.at(index));
+        BOOST_REQUIRE(input);
+        BOOST_REQUIRE(*input == *ins.at(index));
+
+        if (index > 0u)
+        {
+            const table::input::slab_put_ref prior{ {}, link, index - 1u,
+                *ins.at(index - 1u) };
+            BOOST_REQUIRE_EQUAL(in_fks.at(index),
+                in_fks.at(index - 1u) + prior.count());
+        }
+    }
+
+    const auto& outs = *tx.outputs_ptr();
+    const auto out_fks = query.to_tx_outputs(link);
+    BOOST_REQUIRE_EQUAL(out_fks.size(), outs.size());
+
+    // Each output slab directly follows the preceding output slab of the tx.
+    for (uint32_t index = 0; index < outs.size(); ++index)
+    {
+        BOOST_REQUIRE_EQUAL(query.to_output(link, index), out_fks.at(index));
+        const auto output = query.get_output(out_fks.at(index));
+        BOOST_REQUIRE(output);
+        BOOST_REQUIRE(*output == *outs.at(index));
+
+        if (index > 0u)
+        {
+            const table::output::slab_put_ref prior{ {}, link, index - 1u,
+                *outs.at(index - 1u), store.output.compact() };
+            BOOST_REQUIRE_EQUAL(out_fks.at(index),
+                out_fks.at(index - 1u) + prior.count());
+        }
+    }
+
+    const auto copy = query.get_transaction(link);
+    BOOST_REQUIRE(copy);
+    BOOST_REQUIRE(*copy == tx);
+}
+
 // to_prevout_tx/to_prevout
 
 BOOST_AUTO_TEST_CASE(query_translation__to_prevout_tx__to_prevout__expected)
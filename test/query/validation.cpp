@@ -369,4 +369,111 @@ BOOST_AUTO_TEST_CASE(query_validation__get_tx_state__connected_in_context__tx_di
     BOOST_REQUIRE_EQUAL(sigops, 0u);
 }
 
+BOOST_AUTO_TEST_CASE(query_validation__set_tx_connected__implied_state__not_rewritten)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, {}));
+
+    constexpr context ctx{ 7, 8, 9 };
+    BOOST_REQUIRE(query.set_tx_connected(1, ctx, 42, 24));
+    const auto size = store.validated_tx_body().size();
+
+    // Same result at the same or a greater context is implied.
+    BOOST_REQUIRE(query.set_tx_connected(1, ctx, 42, 24));
+    BOOST_REQUIRE(query.set_tx_connected(1, { 7, 10, 11 }, 42, 24));
+    BOOST_REQUIRE_EQUAL(store.validated_tx_body().size(), size);
+
+    // Lesser context, other flags or other result are not implied.
+    BOOST_REQUIRE(query.set_tx_connected(1, { 7, 6, 9 }, 42, 24));
+    BOOST_REQUIRE(query.set_tx_connected(1, { 3, 8, 9 }, 42, 24));
+    BOOST_REQUIRE(query.set_tx_disconnected(1, { 7, 12, 13 }));
+    BOOST_REQUIRE_GT(store.validated_tx_body().size(), size);
+
+    uint64_t fee{};
+    size_t sigops{};
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(fee, sigops, 1, ctx), error::tx_connected);
+    BOOST_REQUIRE_EQUAL(fee, 42u);
+    BOOST_REQUIRE_EQUAL(sigops, 24u);
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(1, { 7, 12, 13 }), error::tx_disconnected);
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(1, { 3, 8, 9 }), error::tx_connected);
+}
+
+BOOST_AUTO_TEST_CASE(query_validation__set_tx_connected__implied_below_head__rewritten)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, {}));
+    BOOST_REQUIRE(query.set_tx_connected(1, { 7, 8, 9 }, 42, 24));
+    BOOST_REQUIRE(query.set_tx_disconnected(1, { 7, 12, 13 }));
+    const auto size = store.validated_tx_body().size();
+
+    // Implied by a state below the head, which the head precedes.
+    BOOST_REQUIRE(query.set_tx_connected(1, { 7, 10, 11 }, 42, 24));
+    BOOST_REQUIRE_GT(store.validated_tx_body().size(), size);
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(1, { 7, 12, 13 }), error::tx_connected);
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(1, { 7, 8, 9 }), error::tx_connected);
+}
+
+BOOST_AUTO_TEST_CASE(query_validation__get_tx_state__written_elsewhere__current)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    test::query_accessor other{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, {}));
+
+    constexpr context ctx{ 7, 8, 9 };
+    BOOST_REQUIRE(query.set_tx_preconnected(1, ctx));
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(1, ctx), error::tx_preconnected);
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(1, ctx), error::tx_preconnected);
+
+    // A write through another instance is observed.
+    BOOST_REQUIRE(other.set_tx_connected(1, ctx, 42, 24));
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(1, ctx), error::tx_connected);
+}
+
+BOOST_AUTO_TEST_CASE(query_validation__get_tx_state__repeated__cached_until_written)
+{
+    settings settings{};
+    settings.path = TEST_DIRECTORY;
+    test::chunk_store store{ settings };
+    test::query_accessor query{ store };
+    BOOST_REQUIRE_EQUAL(store.create(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, {}));
+    BOOST_REQUIRE(query.set_tx_connected(1, { 7, 8, 9 }, 42, 24));
+
+    uint64_t fee{};
+    size_t sigops{};
+    for (size_t count = 0; count < 3; ++count)
+    {
+        fee = sigops = 0;
+        BOOST_REQUIRE_EQUAL(query.get_tx_state(fee, sigops, 1, { 7, 8, 9 }), error::tx_connected);
+        BOOST_REQUIRE_EQUAL(fee, 42u);
+        BOOST_REQUIRE_EQUAL(sigops, 24u);
+        BOOST_REQUIRE_EQUAL(query.get_tx_state(1, { 3, 8, 9 }), error::unvalidated);
+    }
+
+    // A new head replaces both the cached result and the cached miss.
+    BOOST_REQUIRE(query.set_tx_connected(1, { 3, 8, 9 }, 5, 6));
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(fee, sigops, 1, { 3, 8, 9 }), error::tx_connected);
+    BOOST_REQUIRE_EQUAL(fee, 5u);
+    BOOST_REQUIRE_EQUAL(sigops, 6u);
+    BOOST_REQUIRE_EQUAL(query.get_tx_state(fee, sigops, 1, { 7, 8, 9 }), error::tx_connected);
+    BOOST_REQUIRE_EQUAL(fee, 42u);
+    BOOST_REQUIRE_EQUAL(sigops, 24u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,11 @@ BOOST_AUTO_TEST_CASE(settings__construct__default__expected)
 
     // Archives.
     BOOST_REQUIRE_EQUAL(configuration.path, "bitcoin");
+    BOOST_REQUIRE(!configuration.preallocate);
+    BOOST_REQUIRE(!configuration.preallocate_ahead);
+    BOOST_REQUIRE(!configuration.compact_amounts);
+    BOOST_REQUIRE(!configuration.separate_witness);
+    BOOST_REQUIRE(!configuration.compact_txs);
     BOOST_REQUIRE_EQUAL(configuration.header_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.header_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.header_rate, 50u);
@@ -37,6 +42,8 @@ BOOST_AUTO_TEST_CASE(settings__construct__default__expected)
     BOOST_REQUIRE_EQUAL(configuration.input_rate, 50u);
     BOOST_REQUIRE_EQUAL(configuration.output_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.output_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.witness_size, 1u);
+    BOOST_REQUIRE_EQUAL(configuration.witness_rate, 50u);
     BOOST_REQUIRE_EQUAL(configuration.puts_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.puts_rate, 50u);
     BOOST_REQUIRE_EQUAL(configuration.tx_buckets, 100u);
@@ -54,6 +61,8 @@ BOOST_AUTO_TEST_CASE(settings__construct__default__expected)
     BOOST_REQUIRE_EQUAL(configuration.candidate_rate, 50u);
     BOOST_REQUIRE_EQUAL(configuration.confirmed_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.confirmed_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.indexed_size, 1u);
+    BOOST_REQUIRE_EQUAL(configuration.indexed_rate, 50u);
     BOOST_REQUIRE_EQUAL(configuration.strong_tx_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.strong_tx_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.strong_tx_rate, 50u);
@@ -73,6 +82,9 @@ BOOST_AUTO_TEST_CASE(settings__construct__default__expected)
     BOOST_REQUIRE_EQUAL(configuration.validated_tx_buckets, 100u);
     BOOST_REQUIRE_EQUAL(configuration.validated_tx_size, 1u);
     BOOST_REQUIRE_EQUAL(configuration.validated_tx_rate, 50u);
+    BOOST_REQUIRE_EQUAL(configuration.balance_buckets, 100u);
+    BOOST_REQUIRE_EQUAL(configuration.balance_size, 1u);
+    BOOST_REQUIRE_EQUAL(configuration.balance_rate, 50u);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -17,7 +17,11 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "test.hpp"
+#include <atomic>
+#include <thread>
+#include "mocks/blocks.hpp"
 #include "mocks/map_store.hpp"
+#include "mocks/segment_store.hpp"
 
  // these are the slow tests (mmap)
 
@@ -65,6 +69,8 @@ BOOST_AUTO_TEST_CASE(store__paths__default_configuration__expected)
     BOOST_REQUIRE_EQUAL(instance.input_body_file(), "bitcoin/archive_input.data");
     BOOST_REQUIRE_EQUAL(instance.output_head_file(), "bitcoin/heads/archive_output.head");
     BOOST_REQUIRE_EQUAL(instance.output_body_file(), "bitcoin/archive_output.data");
+    BOOST_REQUIRE_EQUAL(instance.witness_head_file(), "bitcoin/heads/archive_witness.head");
+    BOOST_REQUIRE_EQUAL(instance.witness_body_file(), "bitcoin/archive_witness.data");
     BOOST_REQUIRE_EQUAL(instance.puts_head_file(), "bitcoin/heads/archive_puts.head");
     BOOST_REQUIRE_EQUAL(instance.puts_body_file(), "bitcoin/archive_puts.data");
     BOOST_REQUIRE_EQUAL(instance.tx_head_file(), "bitcoin/heads/archive_tx.head");
@@ -79,6 +85,8 @@ BOOST_AUTO_TEST_CASE(store__paths__default_configuration__expected)
     BOOST_REQUIRE_EQUAL(instance.candidate_body_file(), "bitcoin/candidate.data");
     BOOST_REQUIRE_EQUAL(instance.confirmed_head_file(), "bitcoin/heads/confirmed.head");
     BOOST_REQUIRE_EQUAL(instance.confirmed_body_file(), "bitcoin/confirmed.data");
+    BOOST_REQUIRE_EQUAL(instance.indexed_head_file(), "bitcoin/heads/indexed.head");
+    BOOST_REQUIRE_EQUAL(instance.indexed_body_file(), "bitcoin/indexed.data");
     BOOST_REQUIRE_EQUAL(instance.strong_tx_head_file(), "bitcoin/heads/strong_tx.head");
     BOOST_REQUIRE_EQUAL(instance.strong_tx_body_file(), "bitcoin/strong_tx.data");
 
@@ -93,6 +101,8 @@ BOOST_AUTO_TEST_CASE(store__paths__default_configuration__expected)
     BOOST_REQUIRE_EQUAL(instance.validated_bk_body_file(), "bitcoin/validated_bk.data");
     BOOST_REQUIRE_EQUAL(instance.validated_tx_head_file(), "bitcoin/heads/validated_tx.head");
     BOOST_REQUIRE_EQUAL(instance.validated_tx_body_file(), "bitcoin/validated_tx.data");
+    BOOST_REQUIRE_EQUAL(instance.balance_head_file(), "bitcoin/heads/balance.head");
+    BOOST_REQUIRE_EQUAL(instance.balance_body_file(), "bitcoin/balance.data");
 
     /// Locks.
     BOOST_REQUIRE_EQUAL(instance.flush_lock_file(), "bitcoin/flush.lock");
@@ -161,6 +171,40 @@ BOOST_AUTO_TEST_CASE(store__create__default__success)
     BOOST_REQUIRE_EQUAL(instance.create(), error::success);
 }
 
+BOOST_AUTO_TEST_CASE(store__create__witness_disabled__no_witness_files)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::map_store instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE(!test::exists(instance.witness_head_file()));
+    BOOST_REQUIRE(!test::exists(instance.witness_body_file()));
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.snapshot(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.hot_snapshot(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE(!test::exists(instance.witness_head_file()));
+    BOOST_REQUIRE(!test::exists(instance.witness_body_file()));
+    BOOST_REQUIRE(!test::exists(configuration.path / schema::dir::primary /
+        (std::string{ schema::archive::witness } + schema::ext::head)));
+}
+
+BOOST_AUTO_TEST_CASE(store__create__witness_enabled__witness_files)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    configuration.separate_witness = true;
+    test::map_store instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE(test::exists(instance.witness_head_file()));
+    BOOST_REQUIRE(test::exists(instance.witness_body_file()));
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.snapshot(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE(test::exists(configuration.path / schema::dir::primary /
+        (std::string{ schema::archive::witness } + schema::ext::head)));
+}
+
 // create is index-destructive (by directory)
 BOOST_AUTO_TEST_CASE(store__create__existing_index__success)
 {
@@ -260,6 +304,45 @@ BOOST_AUTO_TEST_CASE(store__open__created__success)
     instance.close();
 }
 
+BOOST_AUTO_TEST_CASE(store__open__missing_version__store_version)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE(test::remove(configuration.path / schema::version::file));
+    BOOST_REQUIRE_EQUAL(instance.open(), error::store_version);
+}
+
+BOOST_AUTO_TEST_CASE(store__open__other_version__store_version)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+
+    system::data_chunk other(add1(array_count<system::half_hash>), 0x00);
+    other.front() = add1(schema::version::value);
+    const auto file = configuration.path / schema::version::file;
+    BOOST_REQUIRE(file::create_file(file, other.data(), other.size()));
+    BOOST_REQUIRE_EQUAL(instance.open(), error::store_version);
+}
+
+BOOST_AUTO_TEST_CASE(store__open__reopened__same_script_ids)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    const auto id = instance.address.script_id(system::chain::script{});
+    BOOST_REQUIRE_NE(id, table::address::script_id(system::chain::script{}, {}));
+
+    store<map> reopened{ configuration };
+    BOOST_REQUIRE_EQUAL(reopened.open(), error::success);
+    BOOST_REQUIRE_EQUAL(reopened.address.script_id(system::chain::script{}), id);
+    reopened.close();
+}
+
 // snapshot
 // ----------------------------------------------------------------------------
 
@@ -291,6 +374,169 @@ BOOST_AUTO_TEST_CASE(store__snapshot__opened__success)
     BOOST_REQUIRE_EQUAL(instance.close(), error::success);
 }
 
+// hot_snapshot
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(store__hot_snapshot__uncreated__backup_table)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.hot_snapshot(), error::backup_table);
+}
+
+BOOST_AUTO_TEST_CASE(store__hot_snapshot__unopened__backup_table)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.hot_snapshot(), error::backup_table);
+}
+
+BOOST_AUTO_TEST_CASE(store__hot_snapshot__opened__success)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.hot_snapshot(), error::success);
+    BOOST_REQUIRE(test::folder(configuration.path / schema::dir::primary));
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(store__hot_snapshot__concurrent_pop_push__consistent_restore)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::map_store instance{ configuration };
+    query<store<map>> query{ instance };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, { 0, 1, 0 }));
+    BOOST_REQUIRE(query.set(test::block1b, { 0, 1, 0 }));
+    BOOST_REQUIRE(query.push_candidate(1));
+
+    // Rewrites the candidate record at height one, below the captured count.
+    std::atomic_bool success{ true };
+    std::thread writer([&]() NOEXCEPT
+    {
+        for (size_t index = 0; index < 100; ++index)
+            success = query.pop_candidate() &&
+                query.push_candidate(is_odd(index) ? 1 : 2) && success;
+    });
+
+    for (size_t index = 0; index < 10; ++index)
+        BOOST_REQUIRE_EQUAL(instance.hot_snapshot(), error::success);
+
+    writer.join();
+    BOOST_REQUIRE(success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.restore(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+
+    // Restored heights reference headers at their own heights.
+    const auto count = instance.candidate.count();
+    BOOST_REQUIRE(count == 1u || count == 2u);
+    BOOST_REQUIRE_EQUAL(query.to_candidate(0), 0u);
+    for (size_t height = 0; height < count; ++height)
+    {
+        context ctx{};
+        BOOST_REQUIRE(query.get_context(ctx, query.to_candidate(height)));
+        BOOST_REQUIRE_EQUAL(ctx.height, height);
+    }
+
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(store__hot_snapshot__concurrent_reindex__consistent_balances)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::map_store instance{ configuration };
+    query<store<map>> query{ instance };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block_spend_genesis, test::context));
+    BOOST_REQUIRE(query.set(test::block1b, test::context));
+    BOOST_REQUIRE(query.set_strong(1));
+    BOOST_REQUIRE(query.push_confirmed(1));
+
+    // Reorganizes between links one and two, which pops address heights and
+    // reverses balances (both in place) before reindexing.
+    std::atomic_bool success{ true };
+    std::thread writer([&]() NOEXCEPT
+    {
+        size_t indexed{};
+        for (size_t index = 0; index < 20; ++index)
+        {
+            const auto from = is_odd(index) ? 2u : 1u;
+            const auto to = is_odd(index) ? 1u : 2u;
+            success = query.index_addresses(indexed, 10) &&
+                query.set_unstrong(from) && query.pop_confirmed() &&
+                query.set_strong(to) && query.push_confirmed(to) && success;
+        }
+
+        success = query.index_addresses(indexed, 10) && success;
+    });
+
+    for (size_t index = 0; index < 10; ++index)
+        BOOST_REQUIRE_EQUAL(instance.hot_snapshot(), error::success);
+
+    writer.join();
+    BOOST_REQUIRE(success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.restore(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+
+    // Restored cached balances agree with the restored address index.
+    size_t indexed{};
+    BOOST_REQUIRE(query.index_addresses(indexed, 10));
+
+    uint64_t cached{};
+    uint64_t value{};
+    size_t outputs{};
+    const auto& genesis = test::genesis.transactions_ptr()->front();
+    const auto& script = genesis->outputs_ptr()->front()->script();
+    BOOST_REQUIRE(query.get_cached_balance(cached, outputs, script));
+    BOOST_REQUIRE(query.get_confirmed_balance(value, script));
+    BOOST_REQUIRE_EQUAL(cached, value);
+    BOOST_REQUIRE_EQUAL(value, query.to_confirmed(1) == 1u ? 0u : 5000000000u);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(store__restore__associated_after_snapshot__query_unassociated)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::map_store instance{ configuration };
+    query<store<map>> query{ instance };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE_EQUAL(instance.snapshot(), error::success);
+
+    // Association is cached by the query when observed.
+    BOOST_REQUIRE(query.set(test::block1, { 0, 1, 0 }));
+    BOOST_REQUIRE(query.push_candidate(1));
+    BOOST_REQUIRE(query.is_associated(1));
+    BOOST_REQUIRE_EQUAL(query.get_last_associated_from(0), 1u);
+
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.restore(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+
+    // The restored store predates the association.
+    BOOST_REQUIRE(query.is_associated(0));
+    BOOST_REQUIRE(!query.is_associated(1));
+    BOOST_REQUIRE_EQUAL(query.get_last_associated_from(0), 0u);
+    BOOST_REQUIRE(query.get_all_unassociated_above(0).empty());
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
 // close
 // ----------------------------------------------------------------------------
 
@@ -336,6 +582,33 @@ BOOST_AUTO_TEST_CASE(store__get_transactor__always__share_locked)
     BOOST_REQUIRE(instance.transactor_mutex().try_lock_shared());
 }
 
+// generation
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(store__generation__create_open__incremented)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    store<map> instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.generation(), zero);
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.generation(), one);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.generation(), two);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.generation(), two);
+}
+
+BOOST_AUTO_TEST_CASE(store__generation__failed_open__unchanged)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::map_store instance{ configuration };
+    instance.transactor_mutex().lock();
+    BOOST_REQUIRE_NE(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.generation(), zero);
+}
+
 // backup
 // ----------------------------------------------------------------------------
 
@@ -578,4 +851,106 @@ BOOST_AUTO_TEST_CASE(store__restore__snapshot__success_unlocks)
     BOOST_REQUIRE(instance.transactor_mutex().try_lock());
 }
 
+BOOST_AUTO_TEST_CASE(store__restore__hot_snapshot__success_unlocks)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::map_store instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.hot_snapshot(), error::success);
+    BOOST_REQUIRE(test::folder(configuration.path / schema::dir::primary));
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.restore(), error::success);
+    BOOST_REQUIRE(!test::folder(configuration.path / schema::dir::primary));
+
+    BOOST_REQUIRE(!test::exists(instance.flush_lock_file()));
+    BOOST_REQUIRE(!test::exists(instance.process_lock_file()));
+    BOOST_REQUIRE(instance.transactor_mutex().try_lock());
+}
+
+// segments
+// ----------------------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(store__segments__create_open_close__success)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::segment_store instance{ configuration };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.snapshot(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(store__segments__blocks__spanning_segments_round_trip)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::segment_store instance{ configuration };
+    test::segment_query query{ instance };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, test::context));
+    BOOST_REQUIRE(query.set(test::block2, test::context));
+    BOOST_REQUIRE(query.set(test::block3, test::context));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.set(test::block2a, test::context));
+    BOOST_REQUIRE_GT(instance.header_segments(), one);
+
+    const auto expect = [&]() NOEXCEPT
+    {
+        for (const auto& block: { test::genesis, test::block1, test::block2,
+            test::block3, test::block1a, test::block2a })
+        {
+            const auto out = query.get_block(query.to_header(block.hash()));
+            BOOST_REQUIRE(out);
+            BOOST_REQUIRE(*out == block);
+        }
+    };
+
+    expect();
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    expect();
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
+BOOST_AUTO_TEST_CASE(store__segments__restore_snapshot__truncated_to_snapshot)
+{
+    settings configuration{};
+    configuration.path = TEST_DIRECTORY;
+    test::segment_store instance{ configuration };
+    test::segment_query query{ instance };
+    BOOST_REQUIRE_EQUAL(instance.create(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+    BOOST_REQUIRE(query.initialize(test::genesis));
+    BOOST_REQUIRE(query.set(test::block1, test::context));
+    BOOST_REQUIRE_EQUAL(instance.snapshot(), error::success);
+    const auto segments = instance.header_segments();
+
+    // Writes beyond the snapshot span more segments, which restore empties.
+    BOOST_REQUIRE(query.set(test::block2, test::context));
+    BOOST_REQUIRE(query.set(test::block3, test::context));
+    BOOST_REQUIRE(query.set(test::block1a, test::context));
+    BOOST_REQUIRE(query.set(test::block2a, test::context));
+    BOOST_REQUIRE_GT(instance.header_segments(), segments);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.restore(), error::success);
+    BOOST_REQUIRE_EQUAL(instance.open(), error::success);
+
+    BOOST_REQUIRE_EQUAL(instance.header_segments(), segments);
+    BOOST_REQUIRE_EQUAL(instance.header.count(), 2u);
+    BOOST_REQUIRE(query.is_block(test::block1.hash()));
+    BOOST_REQUIRE(!query.is_block(test::block2.hash()));
+
+    // Emptied segments are reused.
+    BOOST_REQUIRE(query.set(test::block2, test::context));
+    const auto out = query.get_block(query.to_header(test::block2.hash()));
+    BOOST_REQUIRE(out);
+    BOOST_REQUIRE(*out == test::block2);
+    BOOST_REQUIRE_EQUAL(instance.close(), error::success);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -111,6 +111,31 @@ BOOST_AUTO_TEST_CASE(header__put__get__expected)
     BOOST_REQUIRE(element == expected);
 }
 
+BOOST_AUTO_TEST_CASE(header__put__view__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::header instance{ head_store, body_store, 20 };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.put_link({}, table::header::record{}).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key, expected).is_terminal());
+
+    BOOST_REQUIRE(!table::header::view{ instance.get_memory(table::header::link::terminal) });
+
+    const table::header::view element{ instance.get_memory(1) };
+    BOOST_REQUIRE(element);
+    BOOST_REQUIRE(element.ctx() == expected.ctx);
+    BOOST_REQUIRE_EQUAL(element.flags(), expected.ctx.flags);
+    BOOST_REQUIRE_EQUAL(element.height(), expected.ctx.height);
+    BOOST_REQUIRE_EQUAL(element.mtp(), expected.ctx.mtp);
+    BOOST_REQUIRE_EQUAL(element.parent_fk(), expected.parent_fk);
+    BOOST_REQUIRE_EQUAL(element.version(), expected.version);
+    BOOST_REQUIRE_EQUAL(element.timestamp(), expected.timestamp);
+    BOOST_REQUIRE_EQUAL(element.bits(), expected.bits);
+    BOOST_REQUIRE_EQUAL(element.nonce(), expected.nonce);
+    BOOST_REQUIRE_EQUAL(element.merkle_root(), expected.merkle_root);
+}
+
 BOOST_AUTO_TEST_CASE(header__put_ptr__get__expected)
 {
     test::chunk_storage head_store{};
@@ -207,6 +207,40 @@ BOOST_AUTO_TEST_CASE(input__null_point__compose_terminals__equal)
     BOOST_REQUIRE_EQUAL(in::null_point(), in::compose(in::tx::terminal, in::ix::terminal));
 }
 
+BOOST_AUTO_TEST_CASE(input__put__get_witness_reference__expected)
+{
+    const table::input::slab referenced
+    {
+        {},             // schema::input [all const static members]
+        0x56341201_u32, // parent_fk
+        0x00000000_u32, // index
+        0x56341202_u32, // sequence
+        {},             // script
+        {},             // witness
+        0x0504030201_u64 // witness_fk
+    };
+    const auto expected_body = base16_chunk(
+        "ffffffffff" "11223344556677"
+        "01123456" "00" "02123456" "00" "ff" "0102030405");
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::input instance{ head_store, body_store, 20 };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.put_link(key, referenced).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::input::slab element{};
+    BOOST_REQUIRE(instance.get(0, element));
+    BOOST_REQUIRE(element == referenced);
+
+    table::input::only only{};
+    BOOST_REQUIRE(instance.get(0, only));
+    BOOST_REQUIRE(only.is_external());
+    BOOST_REQUIRE_EQUAL(only.witness_fk, referenced.witness_fk);
+    BOOST_REQUIRE(only.witness->stack().empty());
+}
+
 // get_parent
 // slab_put_ref
 // slab_decomposed_fk
@@ -65,4 +65,225 @@ BOOST_AUTO_TEST_CASE(output__put__get__expected)
     BOOST_REQUIRE(element == expected);
 }
 
+BOOST_AUTO_TEST_CASE(output__put__pay_key_hash__compressed)
+{
+    const auto hash = base16_chunk("0102030405060708090a0b0c0d0e0f1011121314");
+    const chain::script script{ splice(base16_chunk("76a914"), hash,
+        base16_chunk("88ac")), false };
+    const table::output::slab slab{ {}, 0x00000001_u32, 0x02, 0x03, script };
+    const auto expected_body = splice(base16_chunk("01000000" "02" "03" "f6"),
+        hash);
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store };
+    BOOST_REQUIRE(!instance.put_link(slab).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+    BOOST_REQUIRE_EQUAL(slab.count(), expected_body.size());
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE(element == slab);
+    BOOST_REQUIRE_EQUAL(element.script.to_data(false), script.to_data(false));
+
+    table::output::only only{};
+    BOOST_REQUIRE(instance.get<table::output::only>(0, only));
+    BOOST_REQUIRE(only.output);
+    BOOST_REQUIRE_EQUAL(only.output->value(), 0x03u);
+    BOOST_REQUIRE_EQUAL(only.output->script().to_data(false), script.to_data(false));
+}
+
+BOOST_AUTO_TEST_CASE(output__get_script_match__compressed__expected)
+{
+    const auto hash = base16_chunk("0102030405060708090a0b0c0d0e0f1011121314");
+    const chain::script script{ splice(base16_chunk("76a914"), hash,
+        base16_chunk("88ac")), false };
+    const chain::script other{ base16_chunk("51"), false };
+    const table::output::slab slab{ {}, 0x00000001_u32, 0x02, 0x03, script };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store };
+    BOOST_REQUIRE(!instance.put_link(slab).is_terminal());
+
+    const auto bytes = compression::script_to_data(script);
+    table::output::get_script_match same{ {}, bytes };
+    BOOST_REQUIRE(instance.get(0, same));
+    BOOST_REQUIRE(same.match);
+
+    const auto other_bytes = compression::script_to_data(other);
+    table::output::get_script_match differ{ {}, other_bytes };
+    BOOST_REQUIRE(instance.get(0, differ));
+    BOOST_REQUIRE(!differ.match);
+}
+
+BOOST_AUTO_TEST_CASE(output__get_compressed__scripts__expected)
+{
+    const auto hash = base16_chunk("0102030405060708090a0b0c0d0e0f1011121314");
+    const std_vector<chain::script> scripts
+    {
+        chain::script{ splice(base16_chunk("76a914"), hash, base16_chunk("88ac")), false },
+        chain::script{ base16_chunk("51"), false },
+        chain::script{ data_chunk(compression::pay_key_hash, 0x61), false },
+        chain::script{}
+    };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store, true };
+    for (const auto& script: scripts)
+    {
+        const table::output::slab slab{ {}, 0x00000001_u32, 0x02,
+            5'000'000'000_u64, script, true };
+        const auto link = instance.put_link(slab);
+        BOOST_REQUIRE(!link.is_terminal());
+
+        table::output::get_compressed element{};
+        BOOST_REQUIRE(instance.get(link, element));
+        BOOST_REQUIRE_EQUAL(element.value, 5'000'000'000_u64);
+        BOOST_REQUIRE_EQUAL(element.script, compression::script_to_data(script));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(output__put__templates__round_trip)
+{
+    const auto key = base16_chunk("0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20");
+    const auto hash = base16_chunk("0102030405060708090a0b0c0d0e0f1011121314");
+    const std_vector<data_chunk> scripts
+    {
+        splice(base16_chunk("a914"), hash, base16_chunk("87")),
+        splice(base16_chunk("2102"), key, base16_chunk("ac")),
+        splice(base16_chunk("2103"), key, base16_chunk("ac")),
+        splice(base16_chunk("0014"), hash),
+        splice(base16_chunk("0020"), key),
+        splice(base16_chunk("5120"), key)
+    };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store };
+    for (const auto& bytes: scripts)
+    {
+        const table::output::slab slab{ {}, 0x00000001_u32, 0x02, 0x03,
+            chain::script{ bytes, false } };
+
+        // parent_fk, index, value, code, payload.
+        const auto payload = bytes.size() == 22 || bytes.size() == 23 ? 20u : 32u;
+        BOOST_REQUIRE_EQUAL(slab.count(), 4u + 1u + 1u + 1u + payload);
+
+        const auto link = instance.put_link(slab);
+        BOOST_REQUIRE(!link.is_terminal());
+
+        table::output::slab element{};
+        BOOST_REQUIRE(instance.get<table::output::slab>(link, element));
+        BOOST_REQUIRE_EQUAL(element.script.to_data(false), bytes);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(output__put__template_code_size__escaped)
+{
+    // Raw script of size equal to a template code (0xf6), 246 x op_nop.
+    const data_chunk bytes(compression::pay_key_hash, 0x61);
+    const table::output::slab slab{ {}, 0x00000001_u32, 0x02, 0x03,
+        chain::script{ bytes, false } };
+    const auto expected_body = splice(base16_chunk("01000000" "02" "03" "fdf600"),
+        bytes);
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store };
+    BOOST_REQUIRE(!instance.put_link(slab).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+    BOOST_REQUIRE_EQUAL(slab.count(), expected_body.size());
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE_EQUAL(element.script.to_data(false), bytes);
+}
+
+BOOST_AUTO_TEST_CASE(output__put__compact_amount__decoded)
+{
+    // 50 btc is compressed to 0x32, written as non-minimal varint.
+    const chain::output out{ 5'000'000'000_u64, chain::script{} };
+    const auto expected_body = base16_chunk("01000000" "02" "fd3200" "00");
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store, true };
+    BOOST_REQUIRE(instance.compact());
+
+    const table::output::slab_put_ref put{ {}, 0x00000001_u32, 0x02, out,
+        instance.compact() };
+    BOOST_REQUIRE_EQUAL(put.count(), expected_body.size());
+    BOOST_REQUIRE(!instance.put_link(put).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::output::get_value value{};
+    BOOST_REQUIRE(instance.get<table::output::get_value>(0, value));
+    BOOST_REQUIRE_EQUAL(value.value, out.value());
+
+    table::output::only only{};
+    BOOST_REQUIRE(instance.get<table::output::only>(0, only));
+    BOOST_REQUIRE(only.output);
+    BOOST_REQUIRE_EQUAL(only.output->value(), out.value());
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE_EQUAL(element.value, out.value());
+    BOOST_REQUIRE(element.compact);
+    BOOST_REQUIRE_EQUAL(element.count(), expected_body.size());
+}
+
+BOOST_AUTO_TEST_CASE(output__put__compact_slab__round_trip)
+{
+    const auto expected_body = base16_chunk("01000000" "02" "fd3200" "00");
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store, true };
+
+    const table::output::slab put{ {}, 0x00000001_u32, 0x02,
+        5'000'000'000_u64, chain::script{}, true };
+    BOOST_REQUIRE_EQUAL(put.count(), expected_body.size());
+    BOOST_REQUIRE(!instance.put_link(put).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::output::slab element{};
+    BOOST_REQUIRE(instance.get<table::output::slab>(0, element));
+    BOOST_REQUIRE(element == put);
+    BOOST_REQUIRE(element.compact);
+}
+
+BOOST_AUTO_TEST_CASE(output__put__compact_amount_not_smaller__raw)
+{
+    // Compression is not used unless smaller than minimal varint.
+    const chain::output out{ 0xdebc9a7856341201_u64, chain::script{} };
+    const auto expected_body = base16_chunk("01000000" "02" "ff0112345678" "9abcde" "00");
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::output instance{ head_store, body_store, true };
+    const table::output::slab_put_ref put{ {}, 0x00000001_u32, 0x02, out, true };
+    BOOST_REQUIRE(!instance.put_link(put).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::output::get_value value{};
+    BOOST_REQUIRE(instance.get<table::output::get_value>(0, value));
+    BOOST_REQUIRE_EQUAL(value.value, out.value());
+}
+
+BOOST_AUTO_TEST_CASE(output__compression__amounts__round_trip)
+{
+    static_assert(compression::compress_amount(0) == 0u);
+    static_assert(compression::compress_amount(1) == 1u);
+    static_assert(compression::compress_amount(100'000'000) == 9u);
+    static_assert(compression::compress_amount(5'000'000'000) == 50u);
+
+    for (const auto amount: { 0_u64, 1_u64, 546_u64, 123'456'789_u64,
+        100'000'000_u64, 2'100'000'000'000'000_u64 })
+    {
+        BOOST_REQUIRE_EQUAL(compression::decompress_amount(
+            compression::compress_amount(amount)), amount);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
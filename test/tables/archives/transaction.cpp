@@ -126,6 +126,30 @@ BOOST_AUTO_TEST_CASE(transaction__put__get_puts__expected)
     BOOST_REQUIRE(!is_add_overflow<size_t>(element.ins_fk, element.ins_count * schema::put));
 }
 
+BOOST_AUTO_TEST_CASE(transaction__put__view__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::transaction instance{ head_store, body_store, 20 };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.put_link({}, table::transaction::record{}).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(key, expected).is_terminal());
+
+    BOOST_REQUIRE(!table::transaction::view{ instance.get_memory(2) });
+
+    const table::transaction::view element{ instance.get_memory(1) };
+    BOOST_REQUIRE(element);
+    BOOST_REQUIRE_EQUAL(element.coinbase(), expected.coinbase);
+    BOOST_REQUIRE_EQUAL(element.light(), expected.light);
+    BOOST_REQUIRE_EQUAL(element.heavy(), expected.heavy);
+    BOOST_REQUIRE_EQUAL(element.locktime(), expected.locktime);
+    BOOST_REQUIRE_EQUAL(element.version(), expected.version);
+    BOOST_REQUIRE_EQUAL(element.ins_count(), expected.ins_count);
+    BOOST_REQUIRE_EQUAL(element.outs_count(), expected.outs_count);
+    BOOST_REQUIRE_EQUAL(element.ins_fk(), expected.ins_fk);
+    BOOST_REQUIRE_EQUAL(element.outs_fk(), expected.outs_fk());
+}
+
 BOOST_AUTO_TEST_CASE(transaction__it__pk__expected)
 {
     test::chunk_storage head_store{};
@@ -136,4 +136,80 @@ BOOST_AUTO_TEST_CASE(txs__put__get__expected)
     BOOST_REQUIRE(slab == expected3);
 }
 
+BOOST_AUTO_TEST_CASE(txs__put__get_compact__expected)
+{
+    const table::txs::slab compact
+    {
+        {}, // schema::txs [all const static members]
+        std_vector<uint32_t>
+        {
+            0x00000010_u32,
+            0x00000011_u32,
+            0x00000012_u32,
+            0x00000002_u32,
+            0x00000004_u32
+        },
+        true
+    };
+    const data_chunk expected_compact_file
+    {
+        // 00->terminal
+        0xff, 0xff, 0xff, 0xff,
+
+        // key
+        0x11, 0x22, 0x33,
+
+        // count [5] | compact
+        0x05, 0x00, 0x00, 0x80,
+
+        // run [0x10..0x12] (+16, 3)
+        0x20, 0x02,
+
+        // run [0x02] (-17, 1)
+        0x21, 0x00,
+
+        // run [0x04] (+1, 1)
+        0x02, 0x00
+    };
+
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::txs instance{ head_store, body_store, 20, true };
+    BOOST_REQUIRE(instance.compact());
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.put_link(key, compact).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_compact_file);
+    BOOST_REQUIRE_EQUAL(compact.count(), expected_compact_file.size());
+
+    table::txs::slab slab{};
+    BOOST_REQUIRE(instance.get(0, slab));
+    BOOST_REQUIRE(slab == compact);
+    BOOST_REQUIRE(slab.compact);
+
+    table::txs::slab_position position12{ {}, 0x00000012_u32 };
+    BOOST_REQUIRE(instance.get(0, position12));
+    BOOST_REQUIRE_EQUAL(position12.position, 2u);
+
+    table::txs::slab_position position4{ {}, 0x00000004_u32 };
+    BOOST_REQUIRE(instance.get(0, position4));
+    BOOST_REQUIRE_EQUAL(position4.position, 4u);
+
+    table::txs::slab_position missing{ {}, 0x00000003_u32 };
+    BOOST_REQUIRE(!instance.get(0, missing));
+}
+
+BOOST_AUTO_TEST_CASE(txs__get_position__uncompacted__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::txs instance{ head_store, body_store, 20 };
+    BOOST_REQUIRE(!instance.compact());
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(!instance.put_link(key, expected3).is_terminal());
+
+    table::txs::slab_position position{ {}, 0x56341233_u32 };
+    BOOST_REQUIRE(instance.get(0, position));
+    BOOST_REQUIRE_EQUAL(position.position, 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../../test.hpp"
+#include "../../mocks/chunk_storage.hpp"
+
+BOOST_AUTO_TEST_SUITE(witness_tests)
+
+using namespace system;
+const table::witness::slab expected
+{
+    {}, // schema::witness [all const static members]
+    chain::witness{ data_stack{ { 0x01, 0x02 }, { 0x03 } } }
+};
+constexpr auto slab0_size = 1u;
+const data_chunk expected_file
+{
+    // slab
+    0x00,
+
+    // --------------------------------------------------------------------------------------------
+
+    // slab
+    0x02,
+    0x02, 0x01, 0x02,
+    0x01, 0x03
+};
+
+BOOST_AUTO_TEST_CASE(witness__put__get__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::witness instance{ head_store, body_store };
+    BOOST_REQUIRE(!instance.enabled());
+    BOOST_REQUIRE(!instance.put_link(table::witness::slab{}).is_terminal());
+    BOOST_REQUIRE(!instance.put_link(expected).is_terminal());
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_file);
+
+    table::witness::slab element{};
+    BOOST_REQUIRE(instance.get<table::witness::slab>(0, element));
+    BOOST_REQUIRE(element == table::witness::slab{});
+
+    BOOST_REQUIRE(instance.get<table::witness::slab>(slab0_size, element));
+    BOOST_REQUIRE(element == expected);
+}
+
+BOOST_AUTO_TEST_CASE(witness__put_ref__get_only__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::witness instance{ head_store, body_store, true };
+    BOOST_REQUIRE(instance.enabled());
+
+    const auto link = instance.put_link(table::witness::slab_put_ref
+    {
+        {},
+        expected.witness
+    });
+    BOOST_REQUIRE(!link.is_terminal());
+
+    table::witness::only element{};
+    BOOST_REQUIRE(instance.get<table::witness::only>(link, element));
+    BOOST_REQUIRE(element.witness);
+    BOOST_REQUIRE(*element.witness == expected.witness);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2011-2022 libbitcoin developers (see AUTHORS)
+ *
+ * This file is part of libbitcoin.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "../../test.hpp"
+#include "../../mocks/chunk_storage.hpp"
+
+BOOST_AUTO_TEST_SUITE(balance_tests)
+
+using namespace system;
+const table::balance::key key1{ 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+const table::balance::key key2{ 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8 };
+const table::balance::record record1{ {}, 0x0000000042, 0x0000000000000064, 0x00000001 };
+const table::balance::record record2{ {}, 0x1122334455, 0x0102030405060708, 0x00000003 };
+const data_chunk expected_body = base16_chunk
+(
+    "ffffffff"         // next->end
+    "0102030405060708" // key1
+    "4200000000"       // output_fk1
+    "6400000000000000" // value1
+    "01000000"         // outputs1
+
+    "00000000"         // next->
+    "a1a2a3a4a5a6a7a8" // key2
+    "5544332211"       // output_fk2
+    "0807060504030201" // value2
+    "03000000"         // outputs2
+);
+
+BOOST_AUTO_TEST_CASE(balance__put__two__expected)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::balance instance{ head_store, body_store, 1 };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.put(key1, record1));
+    BOOST_REQUIRE(instance.put(key2, record2));
+    BOOST_REQUIRE_EQUAL(body_store.buffer(), expected_body);
+
+    table::balance::record out{};
+    BOOST_REQUIRE(instance.get(instance.first(key1), out));
+    BOOST_REQUIRE(out == record1);
+    BOOST_REQUIRE(instance.get(instance.first(key2), out));
+    BOOST_REQUIRE(out == record2);
+}
+
+BOOST_AUTO_TEST_CASE(balance__set__existing__updated_in_place)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::balance instance{ head_store, body_store, 1 };
+    BOOST_REQUIRE(instance.create());
+    BOOST_REQUIRE(instance.put(key1, record1));
+    BOOST_REQUIRE(instance.put(key2, record2));
+
+    const table::balance::record updated{ {}, table::balance::out::terminal, 0x00000000000000c8, 0x00000002 };
+    BOOST_REQUIRE(instance.set(instance.first(key1), updated));
+    BOOST_REQUIRE_EQUAL(body_store.buffer().size(), expected_body.size());
+
+    table::balance::record out{};
+    BOOST_REQUIRE(instance.get(instance.first(key1), out));
+    BOOST_REQUIRE(out == updated);
+    BOOST_REQUIRE(out.is_collided());
+    BOOST_REQUIRE(instance.get(instance.first(key2), out));
+    BOOST_REQUIRE(out == record2);
+    BOOST_REQUIRE(!out.is_collided());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
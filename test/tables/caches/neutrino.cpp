@@ -95,4 +95,38 @@ BOOST_AUTO_TEST_CASE(neutrino__get__two__expected)
     BOOST_REQUIRE(out == slab2);
 }
 
+BOOST_AUTO_TEST_CASE(neutrino__get_view__two__expected)
+{
+    auto head = expected_head;
+    auto body = expected_body;
+    test::chunk_storage head_store{ head };
+    test::chunk_storage body_store{ body };
+    table::neutrino instance{ head_store, body_store, 5 };
+
+    table::neutrino::view out{};
+    BOOST_REQUIRE(instance.get_view(out, 0u));
+    BOOST_REQUIRE(out.memory);
+    BOOST_REQUIRE_EQUAL(out.filter_head, slab1.filter_head);
+    BOOST_REQUIRE_EQUAL(out.filter.to_chunk(), slab1.filter);
+    BOOST_REQUIRE(instance.get_view(out, 0x2a));
+    BOOST_REQUIRE_EQUAL(out.filter_head, slab2.filter_head);
+    BOOST_REQUIRE_EQUAL(out.filter.to_chunk(), slab2.filter);
+
+    // The view references the body buffer (not a copy).
+    BOOST_REQUIRE(out.filter.data() == std::next(body.data(), 0x2a + 5 + 3 + 32 + 1));
+}
+
+BOOST_AUTO_TEST_CASE(neutrino__get_view__terminal__false)
+{
+    auto head = expected_head;
+    auto body = expected_body;
+    test::chunk_storage head_store{ head };
+    test::chunk_storage body_store{ body };
+    table::neutrino instance{ head_store, body_store, 5 };
+
+    table::neutrino::view out{};
+    BOOST_REQUIRE(!instance.get_view(out, table::neutrino::link::terminal));
+    BOOST_REQUIRE(!out.memory);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -17,17 +17,18 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "../../test.hpp"
+#include "../../mocks/blocks.hpp"
 #include "../../mocks/chunk_storage.hpp"
 
 BOOST_AUTO_TEST_SUITE(address_tests)
 
 using namespace system;
-const table::address::key key1 = base16_array("100000000000000000000000000000000000000000000000000000000000000a");
-const table::address::key key2 = base16_array("200000000000000000000000000000000000000000000000000000000000000b");
-const table::address::record in1{ {}, 0x1234567890abcdef };
+const table::address::key key1 = base16_array("100000000000000a");
+const table::address::key key2 = base16_array("200000000000000c");
+const table::address::record in1{ {}, 0x1234567890abcdef, 0x00000001 };
 const table::address::record in2{ {}, 0xabcdef1234567890 };
-const table::address::record out1{ {}, 0x0000007890abcdef };
-const table::address::record out2{ {}, 0x0000001234567890 };
+const table::address::record out1{ {}, 0x0000007890abcdef, 0x00000001 };
+const table::address::record out2{ {}, 0x0000001234567890, 0x00ffffff };
 const data_chunk expected_head = base16_chunk
 (
     "00000000"
@@ -49,14 +50,50 @@ const data_chunk closed_head = base16_chunk
 const data_chunk expected_body = base16_chunk
 (
     "ffffffff"   // next->end
-    "100000000000000000000000000000000000000000000000000000000000000a" // key1
+    "100000000000000a" // key1
     "efcdab9078" // output1 [low 5 bytes]
+    "010000"     // height1
 
     "ffffffff"   // next->end
-    "200000000000000000000000000000000000000000000000000000000000000b" // key2
+    "200000000000000c" // key2
     "9078563412" // output2 [low 5 bytes]
+    "ffffff"     // height2 [unconfirmed]
 );
 
+BOOST_AUTO_TEST_CASE(address__script_id__empty_null_salt__expected)
+{
+    BOOST_REQUIRE_EQUAL(table::address::script_id(chain::script{}, {}), base16_array("8dc5fb49aa0b5a8b"));
+}
+
+BOOST_AUTO_TEST_CASE(address__script_id__genesis_null_salt__expected)
+{
+    const auto& output = *test::genesis.transactions_ptr()->front()->outputs_ptr()->front();
+    BOOST_REQUIRE_EQUAL(table::address::script_id(output.script(), {}), base16_array("4d2621e15e687447"));
+}
+
+BOOST_AUTO_TEST_CASE(address__script_id__compressed__same_as_script)
+{
+    const half_hash salt{ 0x01 };
+    const auto& output = *test::genesis.transactions_ptr()->front()->outputs_ptr()->front();
+    const chain::script pay_key_hash{ base16_chunk("76a914" "0102030405060708090a0b0c0d0e0f1011121314" "88ac"), false };
+    BOOST_REQUIRE_EQUAL(table::address::script_id(compression::script_to_data(output.script()), salt), table::address::script_id(output.script(), salt));
+    BOOST_REQUIRE_EQUAL(table::address::script_id(compression::script_to_data(pay_key_hash), salt), table::address::script_id(pay_key_hash, salt));
+}
+
+BOOST_AUTO_TEST_CASE(address__script_id__salted__salt_dependent)
+{
+    test::chunk_storage head_store{};
+    test::chunk_storage body_store{};
+    table::address instance{ head_store, body_store, 5 };
+    const auto& output = *test::genesis.transactions_ptr()->front()->outputs_ptr()->front();
+    BOOST_REQUIRE_EQUAL(instance.script_id(output.script()), table::address::script_id(output.script(), {}));
+
+    const half_hash salt{ 0x01 };
+    instance.set_salt(salt);
+    BOOST_REQUIRE_EQUAL(instance.script_id(output.script()), table::address::script_id(output.script(), salt));
+    BOOST_REQUIRE_NE(instance.script_id(output.script()), table::address::script_id(output.script(), {}));
+}
+
 BOOST_AUTO_TEST_CASE(address__put__two__expected)
 {
     test::chunk_storage head_store{};
@@ -93,6 +130,7 @@ BOOST_AUTO_TEST_CASE(address__get__two__expected)
     BOOST_REQUIRE(out == out1);
     BOOST_REQUIRE(instance.get(1, out));
     BOOST_REQUIRE(out == out2);
+    BOOST_REQUIRE(!out.is_confirmed());
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -78,4 +78,71 @@ BOOST_AUTO_TEST_CASE(height__get__two__expected)
     BOOST_REQUIRE(out == out2);
 }
 
+BOOST_AUTO_TEST_CASE(height__get__range__expected)
+{
+    auto head = expected_head;
+    auto body = expected_body;
+    test::chunk_storage head_store{ head };
+    test::chunk_storage body_store{ body };
+    table::height instance{ head_store, body_store };
+
+    table::height::record_range out{};
+    out.header_fks.resize(two);
+    BOOST_REQUIRE(instance.get(0u, out));
+    BOOST_REQUIRE_EQUAL(out.header_fks.size(), two);
+    BOOST_REQUIRE_EQUAL(out.header_fks.front(), out1.header_fk);
+    BOOST_REQUIRE_EQUAL(out.header_fks.back(), out2.header_fk);
+
+    // Truncated at the end of the body.
+    out.header_fks.resize(two);
+    BOOST_REQUIRE(instance.get(1u, out));
+    BOOST_REQUIRE_EQUAL(out.header_fks.size(), one);
+    BOOST_REQUIRE_EQUAL(out.header_fks.front(), out2.header_fk);
+}
+
+BOOST_AUTO_TEST_CASE(height__put__segmented_body__expected_links)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    // Ten byte segments are aligned to three (three byte) records.
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 10 };
+    table::height instance{ head_store, body_store };
+    BOOST_REQUIRE_EQUAL(body_store.segment(), 9u);
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    for (uint32_t index = 0; index < 7u; ++index)
+    {
+        table::height::link link{};
+        BOOST_REQUIRE(instance.put_link(link, table::height::record{ {}, add1(index) }));
+        BOOST_REQUIRE_EQUAL(link, index);
+    }
+
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+    BOOST_REQUIRE_EQUAL(instance.count(), 7u);
+
+    table::height::record out{};
+    for (uint32_t index = 0; index < 7u; ++index)
+    {
+        BOOST_REQUIRE(instance.get(index, out));
+        BOOST_REQUIRE_EQUAL(out.header_fk, add1(index));
+    }
+
+    // A range read ends at the segment containing its first record.
+    table::height::record_range range{};
+    range.header_fks.resize(7u);
+    BOOST_REQUIRE(instance.get(1u, range));
+    BOOST_REQUIRE_EQUAL(range.header_fks.size(), 2u);
+    BOOST_REQUIRE_EQUAL(range.header_fks.front(), 2u);
+    BOOST_REQUIRE_EQUAL(range.header_fks.back(), 3u);
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
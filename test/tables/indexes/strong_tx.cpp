@@ -95,4 +95,43 @@ BOOST_AUTO_TEST_CASE(strong_tx__get__two__expected)
     BOOST_REQUIRE(out == out2);
 }
 
+BOOST_AUTO_TEST_CASE(strong_tx__put__segmented_body__expected_links)
+{
+    BOOST_REQUIRE(test::clear(test::directory));
+    const std::string file = TEST_PATH;
+    BOOST_REQUIRE(test::create(file));
+
+    // Thirty byte segments are aligned to two (eleven byte) records.
+    test::chunk_storage head_store{};
+    segments body_store{ file, 1, 0, false, false, 30 };
+    table::strong_tx instance{ head_store, body_store, 5 };
+    BOOST_REQUIRE_EQUAL(body_store.segment(), 22u);
+    BOOST_REQUIRE_EQUAL(body_store.open(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.load(), error::success);
+    BOOST_REQUIRE(instance.create());
+
+    for (uint8_t index = 0; index < 5u; ++index)
+    {
+        table::strong_tx::link link{};
+        const table::strong_tx::key key{ index, 0x02, 0x03, 0x04 };
+        BOOST_REQUIRE(instance.put_link(link, key, table::strong_tx::record{ {}, add1(index) }));
+        BOOST_REQUIRE_EQUAL(link, index);
+    }
+
+    BOOST_REQUIRE_EQUAL(body_store.count(), 3u);
+
+    table::strong_tx::record out{};
+    for (uint8_t index = 0; index < 5u; ++index)
+    {
+        const table::strong_tx::key key{ index, 0x02, 0x03, 0x04 };
+        BOOST_REQUIRE_EQUAL(instance.first(key), index);
+        BOOST_REQUIRE(instance.get(instance.first(key), out));
+        BOOST_REQUIRE_EQUAL(out.header_fk, add1(index));
+    }
+
+    BOOST_REQUIRE_EQUAL(body_store.unload(), error::success);
+    BOOST_REQUIRE_EQUAL(body_store.close(), error::success);
+    BOOST_REQUIRE(test::clear(test::directory));
+}
+
 BOOST_AUTO_TEST_SUITE_END()